@@ -1,12 +1,74 @@
+#pragma once
 #include <stdbool.h>
+#include <stddef.h>
+
+typedef enum
+{
+    STACK_OK = 0,
+    // pop or peek on fewer elements than requested; nothing was removed
+    STACK_EMPTY,
+    // the allocator returned NULL; the stack is unchanged
+    STACK_NO_MEMORY,
+    // NULL stack or a zero element size
+    STACK_INVALID_ARGUMENT,
+} StackStatus;
+
+// Resizes ptr from oldSize to newSize bytes like realloc, keeping the first min(oldSize, newSize) bytes:
+// ptr is NULL for a new block, and newSize 0 frees the block and returns NULL. Returns NULL on failure.
+typedef void* (*StackResizeFunction)(void* context, void* ptr, size_t oldSize, size_t newSize);
+
+typedef struct
+{
+    StackResizeFunction resize;
+    void* context;
+} StackAllocator;
 
 typedef struct
 {
-    int* items;
-    int capacity;
-    int top;
+    void* items;
+    // in elements
+    size_t capacity;
+    // index of the top element, -1 when empty
+    ptrdiff_t top;
+    size_t elemSize;
+    StackAllocator allocator;
 } Stack;
 
+// Status-returning API for elements of any size. Nothing here prints or exits; every function that can
+// fail leaves the stack unchanged when it does.
+
+// allocator NULL means malloc/realloc/free; storage is allocated on the first push
+StackStatus stackInit(Stack* s, size_t elemSize, const StackAllocator* allocator);
+void stackDestroy(Stack* s);
+// copies elemSize bytes from elem
+StackStatus stackPush(Stack* s, const void* elem);
+// copies the top element to out unless out is NULL
+StackStatus stackPop(Stack* s, void* out);
+StackStatus stackPeek(const Stack* s, void* out);
+// pushes n elements from elems, bottom to top, growing at most once
+StackStatus stackPushN(Stack* s, const void* elems, size_t n);
+// removes the top n elements and copies them bottom to top to out unless out is NULL, so
+// stackPushN(s, out, n) restores them; STACK_EMPTY when there are fewer than n
+StackStatus stackPopN(Stack* s, void* out, size_t n);
+StackStatus stackReserve(Stack* s, size_t capacity);
+size_t stackSize(const Stack* s);
+const char* stackStatusMessage(StackStatus status);
+
+// Bump allocator over caller-provided memory. Stacks that use it need no stackDestroy: one
+// stackArenaReset releases all of them at once, after which they must not be used again.
+typedef struct
+{
+    unsigned char* memory;
+    size_t size;
+    size_t used;
+} StackArena;
+
+void stackArenaInit(StackArena* arena, void* memory, size_t size);
+StackAllocator stackArenaAllocator(StackArena* arena);
+void stackArenaReset(StackArena* arena);
+
+// The original int stack, as thin wrappers over the API above. They print a message and exit(1) on
+// allocation failure or when popping an empty stack.
 void init(Stack* s);
 void destroy(Stack* s);
 void push(Stack* s, int item);
@@ -1,53 +1,197 @@
 #include "Stack.h"
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define MIN_CAPACITY 8
 
-void init(Stack* s) {
-    s->capacity = MIN_CAPACITY;
-    s->items = malloc(s->capacity * sizeof(int));
-
-    if (NULL == s->items) {
-        printf("malloc failed \n");
-        exit(1);
+static void* heapResize(void* context, void* ptr, size_t oldSize, size_t newSize) {
+    (void)context;
+    (void)oldSize;
+    if (0 == newSize) {
+        free(ptr);
+        return NULL;
     }
+    return realloc(ptr, newSize);
+}
+
+static unsigned char* elementAt(const Stack* s, size_t index) {
+    return (unsigned char*)s->items + index * s->elemSize;
+}
 
+// moves the elements into a buffer of exactly newCapacity >= stackSize(s) elements
+static StackStatus resizeItems(Stack* s, size_t newCapacity) {
+    if (newCapacity > SIZE_MAX / s->elemSize) return STACK_NO_MEMORY;
+    void* items = s->allocator.resize(s->allocator.context, s->items, s->capacity * s->elemSize,
+                                      newCapacity * s->elemSize);
+    if (NULL == items) return STACK_NO_MEMORY;
+    s->items = items;
+    s->capacity = newCapacity;
+    return STACK_OK;
+}
+
+// makes room for n more elements with one resize, at least doubling the capacity
+static StackStatus growFor(Stack* s, size_t n) {
+    const size_t size = stackSize(s);
+    if (n > SIZE_MAX - size) return STACK_NO_MEMORY;
+    if (size + n <= s->capacity) return STACK_OK;
+    size_t newCapacity = s->capacity < MIN_CAPACITY ? MIN_CAPACITY : s->capacity;
+    while (newCapacity < size + n) newCapacity = newCapacity > SIZE_MAX / 2 ? size + n : 2 * newCapacity;
+    return resizeItems(s, newCapacity);
+}
+
+StackStatus stackInit(Stack* s, size_t elemSize, const StackAllocator* allocator) {
+    if (NULL == s || 0 == elemSize) return STACK_INVALID_ARGUMENT;
+    if (NULL != allocator && NULL == allocator->resize) return STACK_INVALID_ARGUMENT;
+    s->items = NULL;
+    s->capacity = 0;
     s->top = -1;
+    s->elemSize = elemSize;
+    if (NULL == allocator) {
+        s->allocator.resize = heapResize;
+        s->allocator.context = NULL;
+    }
+    else {
+        s->allocator = *allocator;
+    }
+    return STACK_OK;
 }
 
-void destroy(Stack* s) {
-    free(s->items);
+// keeps the element size and allocator, so the stack can be used again
+void stackDestroy(Stack* s) {
+    if (NULL != s->items) s->allocator.resize(s->allocator.context, s->items, s->capacity * s->elemSize, 0);
     s->items = NULL;
     s->capacity = 0;
     s->top = -1;
 }
 
-void push(Stack* s, int item) {
-    if (s->capacity - s->top - 1 <= 0) {
-        s->capacity *= 2;
-
-        int* temp = realloc(s->items, s->capacity * sizeof(int));
-        if (NULL == temp) {
-            printf("realloc failed \n");
-            destroy(s);
-            exit(1);
+StackStatus stackPush(Stack* s, const void* elem) { return stackPushN(s, elem, 1); }
+
+StackStatus stackPop(Stack* s, void* out) { return stackPopN(s, out, 1); }
+
+StackStatus stackPeek(const Stack* s, void* out) {
+    if (NULL == s) return STACK_INVALID_ARGUMENT;
+    if (s->top < 0) return STACK_EMPTY;
+    if (NULL != out) memcpy(out, elementAt(s, s->top), s->elemSize);
+    return STACK_OK;
+}
+
+StackStatus stackPushN(Stack* s, const void* elems, size_t n) {
+    if (NULL == s || 0 == s->elemSize || (NULL == elems && n > 0)) return STACK_INVALID_ARGUMENT;
+    if (0 == n) return STACK_OK;
+    const StackStatus status = growFor(s, n);
+    if (STACK_OK != status) return status;
+    memcpy(elementAt(s, stackSize(s)), elems, n * s->elemSize);
+    s->top += (ptrdiff_t)n;
+    return STACK_OK;
+}
+
+StackStatus stackPopN(Stack* s, void* out, size_t n) {
+    if (NULL == s) return STACK_INVALID_ARGUMENT;
+    if (n > stackSize(s)) return STACK_EMPTY;
+    if (0 == n) return STACK_OK;
+    s->top -= (ptrdiff_t)n;
+    if (NULL != out) memcpy(out, elementAt(s, s->top + 1), n * s->elemSize);
+    return STACK_OK;
+}
+
+StackStatus stackReserve(Stack* s, size_t capacity) {
+    if (NULL == s || 0 == s->elemSize) return STACK_INVALID_ARGUMENT;
+    if (capacity <= s->capacity) return STACK_OK;
+    return resizeItems(s, capacity);
+}
+
+size_t stackSize(const Stack* s) { return (size_t)(s->top + 1); }
+
+const char* stackStatusMessage(StackStatus status) {
+    switch (status) {
+    case STACK_OK:
+        return "ok";
+    case STACK_EMPTY:
+        return "stack has fewer elements than requested";
+    case STACK_NO_MEMORY:
+        return "out of memory";
+    case STACK_INVALID_ARGUMENT:
+        return "invalid argument";
+    }
+    return "unknown status";
+}
+
+// rounds n up so every block starts at the strictest fundamental alignment
+static size_t alignUp(size_t n) {
+    const size_t alignment = _Alignof(max_align_t);
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+// The newest block grows, shrinks and is freed in place; any other block is copied to fresh space when it
+// grows and only released by stackArenaReset.
+static void* arenaResize(void* context, void* ptr, size_t oldSize, size_t newSize) {
+    StackArena* arena = context;
+    unsigned char* block = ptr;
+    if (newSize > arena->size) return NULL;
+    if (NULL != block && block + alignUp(oldSize) == arena->memory + arena->used) {
+        const size_t start = (size_t)(block - arena->memory);
+        if (0 == newSize) {
+            arena->used = start;
+            return NULL;
         }
-        s->items = temp;
+        if (alignUp(newSize) > arena->size - start) return NULL;
+        arena->used = start + alignUp(newSize);
+        return block;
+    }
+    if (0 == newSize) return NULL;
+    if (alignUp(newSize) > arena->size - arena->used) return NULL;
+    unsigned char* fresh = arena->memory + arena->used;
+    arena->used += alignUp(newSize);
+    if (NULL != block) memcpy(fresh, block, oldSize < newSize ? oldSize : newSize);
+    return fresh;
+}
+
+void stackArenaInit(StackArena* arena, void* memory, size_t size) {
+    const size_t padding = (size_t)(-(uintptr_t)memory & (_Alignof(max_align_t) - 1));
+    arena->memory = (unsigned char*)memory + padding;
+    arena->size = size > padding ? (size - padding) / _Alignof(max_align_t) * _Alignof(max_align_t) : 0;
+    arena->used = 0;
+}
+
+StackAllocator stackArenaAllocator(StackArena* arena) {
+    StackAllocator allocator = {arenaResize, arena};
+    return allocator;
+}
+
+void stackArenaReset(StackArena* arena) { arena->used = 0; }
+
+void init(Stack* s) {
+    if (STACK_OK != stackInit(s, sizeof(int), NULL) || STACK_OK != stackReserve(s, MIN_CAPACITY)) {
+        printf("malloc failed \n");
+        exit(1);
+    }
+}
+
+void destroy(Stack* s) { stackDestroy(s); }
+
+// push and pop store the int directly when they can, and only go through the generic API to grow or fail
+void push(Stack* s, int item) {
+    if (stackSize(s) < s->capacity) {
+        ((int*)s->items)[++s->top] = item;
+        return;
+    }
+    if (STACK_OK != stackPush(s, &item)) {
+        printf("realloc failed \n");
+        destroy(s);
+        exit(1);
     }
-    s->top++;
-    s->items[s->top] = item;
 }
 
 int pop(Stack* s) {
-    if (isEmpty(s)) {
+    if (s->top >= 0) return ((int*)s->items)[s->top--];
+    int item;
+    if (STACK_OK != stackPop(s, &item)) {
         printf("Stack is empty \n");
         destroy(s);
         exit(1);
     }
-
-    int item = s->items[s->top];
-    s->top--;
     return item;
 }
 
@@ -4,6 +4,7 @@ extern "C" {
 #include "../include/Stack.h"
 #include <limits.h>
 }
+#include <vector>
 
 TEST(InitializeStack, CreatesEmptyStack) {
     Stack stack;
@@ -108,7 +109,132 @@ TEST(DestroyContract, FieldsAreResetAndPointerNulled) {
     destroy(&s);
 
     EXPECT_EQ(nullptr, s.items);
-    EXPECT_EQ(0, s.capacity);
+    EXPECT_EQ(0u, s.capacity);
     EXPECT_EQ(-1, s.top);
 
 }
+
+struct Point
+{
+    double x, y;
+    char label[12];
+};
+
+TEST(GenericStack, StoresElementsOfAnySize) {
+    Stack s;
+    ASSERT_EQ(STACK_OK, stackInit(&s, sizeof(Point), NULL));
+    for (int i = 0; i < 20; ++i) {
+        Point p = {i * 1.5, -i * 1.0, "point"};
+        ASSERT_EQ(STACK_OK, stackPush(&s, &p));
+    }
+    EXPECT_EQ(20u, stackSize(&s));
+    Point top;
+    ASSERT_EQ(STACK_OK, stackPeek(&s, &top));
+    EXPECT_EQ(19 * 1.5, top.x);
+    for (int i = 19; i >= 0; --i) {
+        ASSERT_EQ(STACK_OK, stackPop(&s, &top));
+        EXPECT_EQ(-i * 1.0, top.y);
+        EXPECT_STREQ("point", top.label);
+    }
+    stackDestroy(&s);
+}
+
+TEST(GenericStack, ReportsErrorsInsteadOfExiting) {
+    Stack s;
+    EXPECT_EQ(STACK_INVALID_ARGUMENT, stackInit(&s, 0, NULL));
+    ASSERT_EQ(STACK_OK, stackInit(&s, sizeof(int), NULL));
+    int item = 7;
+    EXPECT_EQ(STACK_EMPTY, stackPop(&s, &item));
+    EXPECT_EQ(STACK_EMPTY, stackPeek(&s, &item));
+    EXPECT_EQ(7, item);
+    ASSERT_EQ(STACK_OK, stackPush(&s, &item));
+    int out[2] = {0, 0};
+    EXPECT_EQ(STACK_EMPTY, stackPopN(&s, out, 2));
+    EXPECT_EQ(1u, stackSize(&s));
+    EXPECT_STREQ("stack has fewer elements than requested", stackStatusMessage(STACK_EMPTY));
+    stackDestroy(&s);
+}
+
+TEST(GenericStack, BulkPushAndPopRoundTrip) {
+    Stack s;
+    ASSERT_EQ(STACK_OK, stackInit(&s, sizeof(int), NULL));
+    std::vector<int> values(1000);
+    for (int i = 0; i < 1000; ++i) values[i] = i;
+    ASSERT_EQ(STACK_OK, stackPushN(&s, values.data(), values.size()));
+
+    std::vector<int> out(600);
+    ASSERT_EQ(STACK_OK, stackPopN(&s, out.data(), out.size()));
+    EXPECT_EQ(std::vector<int>(values.begin() + 400, values.end()), out);
+    EXPECT_EQ(400u, stackSize(&s));
+    ASSERT_EQ(STACK_OK, stackPushN(&s, out.data(), out.size()));
+    int top;
+    ASSERT_EQ(STACK_OK, stackPop(&s, &top));
+    EXPECT_EQ(999, top);
+    stackDestroy(&s);
+}
+
+// fails every allocation once the budget is spent
+struct Budget
+{
+    int resizesLeft;
+};
+
+static void* limitedResize(void* context, void* ptr, size_t, size_t newSize) {
+    if (0 == newSize) {
+        free(ptr);
+        return NULL;
+    }
+    Budget* budget = static_cast<Budget*>(context);
+    if (budget->resizesLeft-- <= 0) return NULL;
+    return realloc(ptr, newSize);
+}
+
+TEST(GenericStack, FailedGrowthLeavesTheStackUnchanged) {
+    Budget budget = {1};
+    StackAllocator allocator = {limitedResize, &budget};
+    Stack s;
+    ASSERT_EQ(STACK_OK, stackInit(&s, sizeof(int), &allocator));
+    for (int i = 0; i < 8; ++i) ASSERT_EQ(STACK_OK, stackPush(&s, &i));
+    int item = 8;
+    EXPECT_EQ(STACK_NO_MEMORY, stackPush(&s, &item));
+    EXPECT_EQ(8u, stackSize(&s));
+    EXPECT_EQ(8u, s.capacity);
+    ASSERT_EQ(STACK_OK, stackPop(&s, &item));
+    EXPECT_EQ(7, item);
+    stackDestroy(&s);
+}
+
+TEST(StackArena, StacksShareOneBufferAndAreFreedTogether) {
+    alignas(16) unsigned char memory[4096];
+    StackArena arena;
+    stackArenaInit(&arena, memory, sizeof(memory));
+    const StackAllocator allocator = stackArenaAllocator(&arena);
+
+    Stack a, b;
+    ASSERT_EQ(STACK_OK, stackInit(&a, sizeof(int), &allocator));
+    ASSERT_EQ(STACK_OK, stackInit(&b, sizeof(double), &allocator));
+    // interleaved growth: a is no longer the newest block when it grows, so it is copied
+    for (int i = 0; i < 100; ++i) {
+        const double d = i;
+        ASSERT_EQ(STACK_OK, stackPush(&a, &i));
+        ASSERT_EQ(STACK_OK, stackPush(&b, &d));
+    }
+    for (int i = 99; i >= 0; --i) {
+        int item;
+        double d;
+        ASSERT_EQ(STACK_OK, stackPop(&a, &item));
+        ASSERT_EQ(STACK_OK, stackPop(&b, &d));
+        EXPECT_EQ(i, item);
+        EXPECT_EQ(i, d);
+    }
+    std::vector<int> tooMany(2048);
+    EXPECT_EQ(STACK_NO_MEMORY, stackPushN(&a, tooMany.data(), tooMany.size()));
+    EXPECT_GT(arena.used, 0u);
+
+    stackArenaReset(&arena);
+    EXPECT_EQ(0u, arena.used);
+    Stack c;
+    ASSERT_EQ(STACK_OK, stackInit(&c, sizeof(int), &allocator));
+    ASSERT_EQ(STACK_OK, stackPushN(&c, tooMany.data(), 1000));
+    EXPECT_EQ(1000u, stackSize(&c));
+}
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "/root/repo/1. Stack in C/_gate_build/lib/libgtest.a"
+)
@@ -0,0 +1,214 @@
+// Run with --benchmark_format=json (or csv) for machine-readable output.
+#include <benchmark/benchmark.h>
+#include "ForkJoinPool.h"
+#include "LockFreeStack.h"
+#include "MappedStack.h"
+#include "Stack.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Stack behind one mutex, the way a scheduler shares it today
+class MutexStack {
+private:
+    Stack stack;
+    std::mutex mutex;
+
+public:
+    void push(int item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stack.push(item);
+    }
+    bool tryPop(int& item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stack.isEmpty()) return false;
+        item = stack.pop();
+        return true;
+    }
+};
+
+static MutexStack sharedMutexStack;
+static LockFreeStack sharedLockFreeStack;
+
+// every thread pushes and pops on the one shared stack; items are push/pop pairs
+template <typename SharedStack>
+static void pushPopPairs(benchmark::State& state, SharedStack& stack) {
+    int item = state.thread_index();
+    for (auto _ : state) {
+        stack.push(item);
+        benchmark::DoNotOptimize(stack.tryPop(item));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_MutexStackPushPop(benchmark::State& state) { pushPopPairs(state, sharedMutexStack); }
+static void BM_LockFreeStackPushPop(benchmark::State& state) { pushPopPairs(state, sharedLockFreeStack); }
+
+// range(0) items through one stack, one call per item against one bulk call; the stack is reserved
+// up front so the loops compare the transfer itself
+static void BM_PushSingle(benchmark::State& state) {
+    std::vector<int> values(state.range(0));
+    std::iota(values.begin(), values.end(), 0);
+    Stack stack;
+    stack.reserve(values.size());
+    for (auto _ : state) {
+        for (int value : values) stack.push(value);
+        state.PauseTiming();
+        stack.popN(values.size(), values.begin());
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+}
+
+static void BM_PushRange(benchmark::State& state) {
+    std::vector<int> values(state.range(0));
+    std::iota(values.begin(), values.end(), 0);
+    Stack stack;
+    stack.reserve(values.size());
+    for (auto _ : state) {
+        stack.pushRange(values.begin(), values.end());
+        state.PauseTiming();
+        stack.popN(values.size(), values.begin());
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+}
+
+static void BM_PopSingle(benchmark::State& state) {
+    std::vector<int> values(state.range(0));
+    Stack stack;
+    stack.reserve(values.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        stack.pushRange(values.begin(), values.end());
+        state.ResumeTiming();
+        for (size_t i = values.size(); i > 0; --i) values[i - 1] = stack.pop();
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+}
+
+static void BM_PopN(benchmark::State& state) {
+    std::vector<int> values(state.range(0));
+    Stack stack;
+    stack.reserve(values.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        stack.pushRange(values.begin(), values.end());
+        state.ResumeTiming();
+        stack.popN(values.size(), values.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+}
+
+// the bound the bulk transfers aim for
+static void BM_Memcpy(benchmark::State& state) {
+    std::vector<int> from(state.range(0)), to(state.range(0));
+    for (auto _ : state) {
+        std::memcpy(to.data(), from.data(), from.size() * sizeof(int));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+}
+
+// fork-join workloads; range(0) is the number of worker threads
+struct Fib : Task {
+    int n;
+    long long result = 0;
+
+    explicit Fib(int n) : n(n) {}
+    static long long serial(int n) { return n < 2 ? n : serial(n - 1) + serial(n - 2); }
+    void run() override {
+        // below the cutoff a task costs more than the work it would hand out
+        if (n < 20) {
+            result = serial(n);
+            return;
+        }
+        Fib first(n - 1), second(n - 2);
+        ForkJoinPool::fork(first);
+        second.run();
+        ForkJoinPool::join(first);
+        result = first.result + second.result;
+    }
+};
+
+struct QuickSort : Task {
+    int* first;
+    int* last;
+
+    QuickSort(int* first, int* last) : first(first), last(last) {}
+    void run() override {
+        if (last - first < 4096) {
+            std::sort(first, last);
+            return;
+        }
+        const int pivot = first[(last - first) / 2];
+        int* middle = std::partition(first, last, [pivot](int x) { return x < pivot; });
+        int* upper = std::partition(middle, last, [pivot](int x) { return x == pivot; });
+        QuickSort left(first, middle), right(upper, last);
+        ForkJoinPool::fork(left);
+        right.run();
+        ForkJoinPool::join(left);
+    }
+};
+
+static void BM_ParallelFib(benchmark::State& state) {
+    ForkJoinPool pool(state.range(0));
+    for (auto _ : state) {
+        Fib fib(32);
+        pool.invoke(fib);
+        benchmark::DoNotOptimize(fib.result);
+    }
+}
+
+static void BM_ParallelQuickSort(benchmark::State& state) {
+    ForkJoinPool pool(state.range(0));
+    std::vector<int> values(1 << 22);
+    std::mt19937 random(1);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int& value : values) value = static_cast<int>(random());
+        state.ResumeTiming();
+        QuickSort sort(values.data(), values.data() + values.size());
+        pool.invoke(sort);
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// a deep DFS: range(0) pushes into a fresh stack, then range(0) pops
+template <typename StackType, typename... Args>
+static void BM_DeepPushPop(benchmark::State& state, Args... args) {
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        StackType stack(args...);
+        for (int i = 0; i < n; ++i) stack.push(i);
+        while (!stack.isEmpty()) benchmark::DoNotOptimize(stack.pop());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_DeepPushPopHugePages(benchmark::State& state) {
+    BM_DeepPushPop<MappedStack>(state, MappedStack::DEFAULT_MAX_ITEMS, true);
+}
+
+BENCHMARK(BM_PushSingle)->Arg(1 << 16);
+BENCHMARK(BM_PushRange)->Arg(1 << 16);
+BENCHMARK(BM_PopSingle)->Arg(1 << 16);
+BENCHMARK(BM_PopN)->Arg(1 << 16);
+BENCHMARK(BM_Memcpy)->Arg(1 << 16);
+
+BENCHMARK(BM_MutexStackPushPop)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_LockFreeStackPushPop)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK(BM_ParallelFib)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelQuickSort)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_DeepPushPop, Stack)->Arg(1 << 20)->Arg(1 << 26)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DeepPushPop, MappedStack)->Arg(1 << 20)->Arg(1 << 26)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DeepPushPopHugePages)->Arg(1 << 20)->Arg(1 << 26)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
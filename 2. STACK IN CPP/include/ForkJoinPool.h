@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingDeque;
+
+// Unit of work for ForkJoinPool. A task is owned by whoever forks it, usually as a local in the parent
+// task, and must outlive the join. run() must not throw.
+class Task {
+private:
+    std::atomic<bool> done{false};
+
+    friend class ForkJoinPool;
+    void execute() {
+        run();
+        done.store(true, std::memory_order_release);
+    }
+
+public:
+    virtual ~Task() = default;
+    virtual void run() = 0;
+    bool isDone() const { return done.load(std::memory_order_acquire); }
+};
+
+// Fork-join scheduler: one worker thread per WorkStealingDeque. fork() pushes a task on the calling
+// worker's own deque, join() keeps running tasks (its own newest first, then ones stolen from other
+// workers' oldest) until the joined task is done, so a worker never blocks while there is work.
+//
+// Workers sleep while no invoke() is running.
+class ForkJoinPool {
+private:
+    struct Worker;
+    // the worker running on this thread, nullptr outside every pool
+    static thread_local Worker* currentWorker;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    // tasks handed in by invoke() from outside the pool
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::deque<Task*> submitted;
+    int running = 0;
+    bool stopping = false;
+
+    void workerLoop(Worker& self);
+    // a task from the worker's own deque, another worker's deque or the submissions; nullptr when none
+    Task* findTask(Worker& self);
+    void runSubmitted(Task* task);
+
+public:
+    // can throw std::system_error when a thread cannot be started
+    explicit ForkJoinPool(unsigned threadCount = std::thread::hardware_concurrency());
+    ~ForkJoinPool();
+
+    ForkJoinPool(const ForkJoinPool&) = delete;
+    ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+    // runs task on the pool and waits for it; from inside a task of this pool it simply runs it
+    void invoke(Task& task);
+
+    // From a worker thread fork() makes task available to the pool. Outside a pool it runs task at once,
+    // so code written for the pool also runs sequentially.
+    static void fork(Task& task);
+    // waits for a forked task, running other tasks meanwhile
+    static void join(Task& task);
+
+    size_t size() const { return workers.size(); }
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+static_assert(sizeof(void*) == 8, "LockFreeStack packs a version tag into the upper pointer bits");
+
+// Treiber stack: push and pop are a single compare-and-swap on the head, so any number of threads can
+// use one instance without a lock.
+//
+// Popped nodes are reclaimed with hazard pointers: before a thread reads head->next it publishes head
+// in its hazard slot, and a retired node is reused or freed only once no slot names it. Reclaimed nodes
+// are pushed again by the same thread, so one address can return to the head; the head word therefore
+// carries a 16-bit version tag that every successful push and pop increments, and a CAS against a stale
+// head fails even when it names the same node (ABA).
+//
+// isEmpty() is only a snapshot under concurrency; consumers that race should use tryPop().
+class LockFreeStack {
+private:
+    struct Node {
+        int item;
+        Node* next;
+    };
+
+    // pointer in the low 48 bits, version tag in the high 16 (x86-64 and AArch64 user addresses)
+    std::atomic<uint64_t> head{0};
+
+    static constexpr int TAG_SHIFT = 48;
+    static constexpr uint64_t POINTER_MASK = (uint64_t(1) << TAG_SHIFT) - 1;
+
+    static Node* pointerOf(uint64_t word) { return reinterpret_cast<Node*>(word & POINTER_MASK); }
+    static uint64_t nextWord(uint64_t previous, const Node* node) {
+        return ((previous >> TAG_SHIFT) + 1) << TAG_SHIFT | reinterpret_cast<uintptr_t>(node);
+    }
+
+    // per-thread hazard slot and retired nodes, shared by all stacks
+    struct HazardThread;
+    static HazardThread& hazardThread();
+
+public:
+    LockFreeStack() = default;
+    // not thread-safe: no other thread may use the stack while it is destroyed
+    ~LockFreeStack();
+
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+    // Every operation but isEmpty() can throw std::runtime_error when more threads than there are hazard
+    // slots use lock-free stacks at the same time.
+
+    // can throw std::bad_alloc
+    void push(int item);
+    // can throw exception: std::underflow_error when the stack is empty
+    int pop();
+    // false when the stack is empty
+    bool tryPop(int& item);
+    bool isEmpty() const;
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+
+// Stack for very deep workloads (POSIX only). The constructor reserves address space for maxItems ints
+// with mmap, without backing memory; pages are committed in COMMIT_STEP pieces as the stack grows, so
+// growth never copies and the items never move.
+//
+// With hugePages the range is advised for transparent huge pages (Linux). When pops leave more than
+// 2 * releaseThreshold bytes committed above the top, everything past top + releaseThreshold goes back
+// to the OS with madvise(MADV_DONTNEED).
+class MappedStack {
+private:
+    int* items;
+    size_t count = 0;
+    size_t maxItems;
+    size_t reservedBytes;
+    size_t committedBytes = 0;
+    // items that fit in the committed pages, at most maxItems
+    size_t usable = 0;
+    size_t releaseThreshold;
+
+    // commits the next COMMIT_STEP bytes; can throw std::bad_alloc
+    void commitMore();
+    void releaseAbove(size_t keepBytes);
+
+public:
+    // 2 MiB: one huge page on x86-64, and few enough mprotect calls that growth stays cheap
+    static constexpr size_t COMMIT_STEP = size_t(2) << 20;
+    static constexpr size_t DEFAULT_MAX_ITEMS = size_t(1) << 34;
+    static constexpr size_t DEFAULT_RELEASE_THRESHOLD = size_t(64) << 20;
+
+    // can throw std::bad_alloc when the address space cannot be reserved
+    explicit MappedStack(size_t maxItems = DEFAULT_MAX_ITEMS, bool hugePages = false,
+                         size_t releaseThreshold = DEFAULT_RELEASE_THRESHOLD);
+    ~MappedStack();
+
+    MappedStack(const MappedStack&) = delete;
+    MappedStack& operator=(const MappedStack&) = delete;
+    MappedStack(MappedStack&& toMove) noexcept;
+    MappedStack& operator=(MappedStack&& toMove) noexcept;
+
+    // can throw std::bad_alloc when the stack holds maxItems items or pages cannot be committed
+    void push(int item) {
+        if (count == usable) commitMore();
+        items[count++] = item;
+    }
+    // can throw exception: std::underflow_error when the stack is empty
+    int pop() {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack is empty");
+        }
+        const int item = items[--count];
+        if (committedBytes - count * sizeof(int) > 2 * releaseThreshold) releaseAbove(releaseThreshold);
+        return item;
+    }
+    // can throw exception: std::underflow_error when the stack is empty
+    int peek() const {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack is empty");
+        }
+        return items[count - 1];
+    }
+
+    bool isEmpty() const { return count == 0; }
+    size_t size() const { return count; }
+    size_t getCapacity() const { return maxItems; }
+    // memory currently committed for items, in bytes
+    size_t getCommittedBytes() const { return committedBytes; }
+};
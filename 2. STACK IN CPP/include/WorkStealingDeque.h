@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Task;
+
+// Chase-Lev work-stealing deque of Task pointers. One owner thread pushes and pops at the bottom like a
+// stack, without locks; any number of thieves take the oldest task from the top with a compare-and-swap.
+// Owner and thief only race for the last task, and the CAS on top decides who gets it.
+//
+// The ring starts at MIN_CAPACITY slots and doubles when full, like Stack::push. It cannot realloc in
+// place because a thief may still be reading the old ring, so growth copies the live range into a new
+// ring and keeps the old one until the deque is destroyed (at most as many slots again as the final ring).
+class WorkStealingDeque {
+private:
+    struct Ring {
+        int64_t capacity;
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+
+        explicit Ring(int64_t capacity) : capacity(capacity), slots(new std::atomic<Task*>[capacity]) {}
+        // capacity is a power of two, so indices wrap with a mask
+        std::atomic<Task*>& at(int64_t i) { return slots[i & (capacity - 1)]; }
+    };
+
+    static constexpr int64_t MIN_CAPACITY = 8;
+
+    // thieves take from top, the owner works at bottom; both only ever grow, except pop's bottom - 1
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Ring*> ring;
+    // every ring ever used; only the owner touches this
+    std::vector<std::unique_ptr<Ring>> rings;
+
+    Ring* grow(Ring* old, int64_t top, int64_t bottom);
+
+public:
+    WorkStealingDeque();
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // owner only; can throw std::bad_alloc
+    void push(Task* task);
+    // owner only; the newest task, nullptr when the deque is empty
+    Task* pop();
+    // any thread; the oldest task, nullptr when the deque is empty or another thread took it first
+    Task* steal();
+
+    // only a snapshot under concurrency
+    bool isEmpty() const;
+};
@@ -0,0 +1,124 @@
+#include "../include/ForkJoinPool.h"
+#include "../include/WorkStealingDeque.h"
+
+struct ForkJoinPool::Worker {
+    ForkJoinPool* pool;
+    WorkStealingDeque deque;
+    // xorshift state for picking the first victim to steal from
+    uint32_t random;
+
+    Worker(ForkJoinPool* pool, uint32_t seed) : pool(pool), random(seed) {}
+
+    uint32_t nextRandom() {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        return random;
+    }
+};
+
+thread_local ForkJoinPool::Worker* ForkJoinPool::currentWorker = nullptr;
+
+ForkJoinPool::ForkJoinPool(unsigned threadCount) {
+    if (threadCount == 0) threadCount = 1;
+    for (unsigned i = 0; i < threadCount; ++i) workers.push_back(std::make_unique<Worker>(this, 2 * i + 1));
+    try {
+        for (auto& worker : workers) threads.emplace_back(&ForkJoinPool::workerLoop, this, std::ref(*worker));
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) thread.join();
+        throw;
+    }
+}
+
+ForkJoinPool::~ForkJoinPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) thread.join();
+}
+
+Task* ForkJoinPool::findTask(Worker& self) {
+    if (Task* task = self.deque.pop()) return task;
+    const size_t n = workers.size();
+    const size_t first = self.nextRandom() % n;
+    for (size_t i = 0; i < n; ++i) {
+        Worker& victim = *workers[(first + i) % n];
+        if (&victim == &self) continue;
+        if (Task* task = victim.deque.steal()) return task;
+    }
+    return nullptr;
+}
+
+void ForkJoinPool::runSubmitted(Task* task) {
+    task->execute();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        --running;
+    }
+    finished.notify_all();
+}
+
+void ForkJoinPool::workerLoop(Worker& self) {
+    currentWorker = &self;
+    for (;;) {
+        if (Task* task = findTask(self)) {
+            task->execute();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!submitted.empty()) {
+            Task* task = submitted.front();
+            submitted.pop_front();
+            lock.unlock();
+            runSubmitted(task);
+            continue;
+        }
+        if (stopping) return;
+        if (running == 0) {
+            // nothing in flight anywhere: sleep until the next invoke()
+            wake.wait(lock, [this] { return stopping || running > 0; });
+            continue;
+        }
+        // another worker is busy and may fork soon
+        lock.unlock();
+        std::this_thread::yield();
+    }
+}
+
+void ForkJoinPool::invoke(Task& task) {
+    if (nullptr != currentWorker && currentWorker->pool == this) {
+        task.execute();
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    submitted.push_back(&task);
+    ++running;
+    wake.notify_all();
+    finished.wait(lock, [&task] { return task.isDone(); });
+}
+
+void ForkJoinPool::fork(Task& task) {
+    if (nullptr == currentWorker) {
+        task.execute();
+        return;
+    }
+    currentWorker->deque.push(&task);
+}
+
+void ForkJoinPool::join(Task& task) {
+    Worker* self = currentWorker;
+    while (!task.isDone()) {
+        if (Task* other = self->pool->findTask(*self)) {
+            other->execute();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,157 @@
+#include "../include/LockFreeStack.h"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace {
+// a thread claims one slot on its first push or pop and keeps it until it exits
+constexpr size_t MAX_THREADS = 256;
+// scanning after 2 * MAX_THREADS retirements frees at least half of the retired nodes per scan
+constexpr size_t SCAN_THRESHOLD = 2 * MAX_THREADS;
+
+struct alignas(64) HazardSlot {
+    std::atomic<const void*> pointer{nullptr};
+    std::atomic<bool> owned{false};
+};
+
+HazardSlot hazardSlots[MAX_THREADS];
+} // namespace
+
+struct LockFreeStack::HazardThread {
+    HazardSlot* slot = nullptr;
+    std::vector<Node*> retired;
+    // reclaimed nodes reused by this thread's next pushes instead of going back to the allocator
+    std::vector<Node*> spare;
+
+    HazardThread() {
+        for (auto& candidate : hazardSlots) {
+            bool expected = false;
+            if (!candidate.owned.load(std::memory_order_relaxed) &&
+                candidate.owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                slot = &candidate;
+                return;
+            }
+        }
+        throw std::runtime_error("Too many threads using LockFreeStack");
+    }
+
+    // nodes another thread still protects are handed to the next thread that scans
+    ~HazardThread() {
+        slot->pointer.store(nullptr, std::memory_order_release);
+        scan();
+        if (!retired.empty()) {
+            std::lock_guard<std::mutex> lock(orphanMutex());
+            orphans().insert(orphans().end(), retired.begin(), retired.end());
+        }
+        for (Node* node : spare) delete node;
+        slot->owned.store(false, std::memory_order_release);
+    }
+
+    static std::mutex& orphanMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::vector<Node*>& orphans() {
+        static std::vector<Node*> nodes;
+        return nodes;
+    }
+
+    void retire(Node* node) {
+        retired.push_back(node);
+        if (retired.size() >= SCAN_THRESHOLD) scan();
+    }
+
+    // reclaims every retired node that no hazard slot names
+    void scan() {
+        {
+            std::unique_lock<std::mutex> lock(orphanMutex(), std::try_to_lock);
+            if (lock.owns_lock() && !orphans().empty()) {
+                retired.insert(retired.end(), orphans().begin(), orphans().end());
+                orphans().clear();
+            }
+        }
+        std::vector<const void*> hazards;
+        for (const auto& candidate : hazardSlots) {
+            if (const void* pointer = candidate.pointer.load()) hazards.push_back(pointer);
+        }
+        std::sort(hazards.begin(), hazards.end());
+        auto firstFree = std::partition(retired.begin(), retired.end(), [&](const Node* node) {
+            return std::binary_search(hazards.begin(), hazards.end(), static_cast<const void*>(node));
+        });
+        for (auto it = firstFree; it != retired.end(); ++it) {
+            if (spare.size() < SCAN_THRESHOLD)
+                spare.push_back(*it);
+            else
+                delete *it;
+        }
+        retired.erase(firstFree, retired.end());
+    }
+};
+
+LockFreeStack::HazardThread& LockFreeStack::hazardThread() {
+    thread_local HazardThread state;
+    return state;
+}
+
+LockFreeStack::~LockFreeStack() {
+    Node* node = pointerOf(head.load(std::memory_order_relaxed));
+    while (nullptr != node) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+void LockFreeStack::push(int item) {
+    HazardThread& self = hazardThread();
+    Node* node;
+    if (self.spare.empty()) {
+        node = new Node{item, nullptr};
+    } else {
+        node = self.spare.back();
+        self.spare.pop_back();
+        node->item = item;
+    }
+    uint64_t word = head.load(std::memory_order_relaxed);
+    do {
+        node->next = pointerOf(word);
+    } while (!head.compare_exchange_weak(word, nextWord(word, node), std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+bool LockFreeStack::tryPop(int& item) {
+    HazardThread& self = hazardThread();
+    uint64_t word = head.load(std::memory_order_acquire);
+    while (true) {
+        Node* node = pointerOf(word);
+        if (nullptr == node) {
+            self.slot->pointer.store(nullptr, std::memory_order_release);
+            return false;
+        }
+        // publish, then check that head still names the node: from here on no scan frees it.
+        // Both accesses are sequentially consistent so the check cannot move before the store.
+        self.slot->pointer.store(node);
+        const uint64_t current = head.load();
+        if (current != word) {
+            word = current;
+            continue;
+        }
+        if (head.compare_exchange_weak(word, nextWord(word, node->next))) {
+            self.slot->pointer.store(nullptr, std::memory_order_release);
+            item = node->item;
+            self.retire(node);
+            return true;
+        }
+    }
+}
+
+int LockFreeStack::pop() {
+    int item;
+    if (!tryPop(item)) {
+        throw std::underflow_error("Stack is empty");
+    }
+    return item;
+}
+
+bool LockFreeStack::isEmpty() const { return nullptr == pointerOf(head.load(std::memory_order_acquire)); }
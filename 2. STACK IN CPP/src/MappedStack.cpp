@@ -0,0 +1,83 @@
+#include "../include/MappedStack.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <sys/mman.h>
+#include <utility>
+
+namespace {
+size_t roundUp(size_t bytes, size_t multiple) { return (bytes + multiple - 1) / multiple * multiple; }
+} // namespace
+
+MappedStack::MappedStack(size_t maxItems, bool hugePages, size_t releaseThreshold)
+    : maxItems(maxItems), releaseThreshold(std::max(releaseThreshold, COMMIT_STEP)) {
+    if (maxItems == 0 || maxItems > (SIZE_MAX - 2 * COMMIT_STEP) / sizeof(int)) {
+        throw std::bad_alloc();
+    }
+    reservedBytes = roundUp(maxItems * sizeof(int), COMMIT_STEP);
+    // reserve one step more than needed, so the start can be aligned to a huge page
+    const size_t mappedBytes = reservedBytes + COMMIT_STEP;
+    void* mapped = mmap(nullptr, mappedBytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (MAP_FAILED == mapped) {
+        throw std::bad_alloc();
+    }
+    char* start = static_cast<char*>(mapped);
+    char* aligned = reinterpret_cast<char*>(roundUp(reinterpret_cast<uintptr_t>(start), COMMIT_STEP));
+    if (aligned > start) munmap(start, aligned - start);
+    char* end = aligned + reservedBytes;
+    if (start + mappedBytes > end) munmap(end, start + mappedBytes - end);
+    items = reinterpret_cast<int*>(aligned);
+#ifdef MADV_HUGEPAGE
+    // advisory: without THP support the stack simply uses normal pages
+    if (hugePages) madvise(aligned, reservedBytes, MADV_HUGEPAGE);
+#else
+    (void)hugePages;
+#endif
+}
+
+MappedStack::~MappedStack() {
+    if (nullptr != items) munmap(items, reservedBytes);
+}
+
+MappedStack::MappedStack(MappedStack&& toMove) noexcept
+    : items(std::exchange(toMove.items, nullptr)), count(std::exchange(toMove.count, 0)),
+      maxItems(std::exchange(toMove.maxItems, 0)), reservedBytes(std::exchange(toMove.reservedBytes, 0)),
+      committedBytes(std::exchange(toMove.committedBytes, 0)), usable(std::exchange(toMove.usable, 0)),
+      releaseThreshold(toMove.releaseThreshold) {}
+
+MappedStack& MappedStack::operator=(MappedStack&& toMove) noexcept {
+    if (this != &toMove) {
+        if (nullptr != items) munmap(items, reservedBytes);
+        items = std::exchange(toMove.items, nullptr);
+        count = std::exchange(toMove.count, 0);
+        maxItems = std::exchange(toMove.maxItems, 0);
+        reservedBytes = std::exchange(toMove.reservedBytes, 0);
+        committedBytes = std::exchange(toMove.committedBytes, 0);
+        usable = std::exchange(toMove.usable, 0);
+        releaseThreshold = toMove.releaseThreshold;
+    }
+    return *this;
+}
+
+void MappedStack::commitMore() {
+    if (usable == maxItems) {
+        throw std::bad_alloc();
+    }
+    char* next = reinterpret_cast<char*>(items) + committedBytes;
+    if (0 != mprotect(next, COMMIT_STEP, PROT_READ | PROT_WRITE)) {
+        throw std::bad_alloc();
+    }
+    committedBytes += COMMIT_STEP;
+    usable = std::min(committedBytes / sizeof(int), maxItems);
+}
+
+void MappedStack::releaseAbove(size_t keepBytes) {
+    const size_t newCommitted = roundUp(count * sizeof(int) + keepBytes, COMMIT_STEP);
+    if (newCommitted >= committedBytes) return;
+    char* first = reinterpret_cast<char*>(items) + newCommitted;
+    // DONTNEED frees the pages at once; PROT_NONE returns the range to reserved-only
+    madvise(first, committedBytes - newCommitted, MADV_DONTNEED);
+    mprotect(first, committedBytes - newCommitted, PROT_NONE);
+    committedBytes = newCommitted;
+    usable = std::min(committedBytes / sizeof(int), maxItems);
+}
@@ -18,6 +18,39 @@ Stack::~Stack() {
     top = -1;
 }
 
+void Stack::reserve(size_t newCapacity) {
+    if (newCapacity <= static_cast<size_t>(capacity)) return;
+    int* temp = static_cast<int*>(realloc(items, newCapacity * sizeof(int)));
+    if (nullptr == temp) {
+        throw std::bad_alloc();
+    }
+    items = temp;
+    capacity = static_cast<int>(newCapacity);
+    STACK_TRACE(growth(capacity, size() * sizeof(int)));
+}
+
+void Stack::shrinkToFit() {
+    const int newCapacity = std::max(top + 1, static_cast<int>(MIN_CAPACITY));
+    if (newCapacity >= capacity) return;
+    // best effort: when realloc fails the stack keeps its larger buffer
+    int* temp = static_cast<int*>(realloc(items, newCapacity * sizeof(int)));
+    if (nullptr != temp) {
+        items = temp;
+        capacity = newCapacity;
+    }
+}
+
+void Stack::growFor(size_t n) {
+    const size_t needed = size() + n;
+    if (needed > static_cast<size_t>(capacity)) reserve(std::max(needed, 2 * static_cast<size_t>(capacity)));
+}
+
+void Stack::requireItems(size_t n) const {
+    if (n > size()) {
+        throw std::underflow_error("Stack has fewer items than requested");
+    }
+}
+
 void Stack::push(int item) {
     if (capacity - top - 1 <= 0) {
         capacity *= 2;
@@ -26,9 +59,11 @@ void Stack::push(int item) {
             throw std::bad_alloc();
         }
         items = temp;
+        STACK_TRACE(growth(capacity, size() * sizeof(int)));
     }
     top++;
     items[top] = item;
+    STACK_TRACE(push(1, size()));
 }
 
 int Stack::pop() {
@@ -37,7 +72,15 @@ int Stack::pop() {
     }
     int item = items[top];
     top--;
+    STACK_TRACE(pop(1));
     return item;
 }
 
 bool Stack::isEmpty() const { return top == -1; }
+
+int Stack::peek() const {
+    if (isEmpty()) {
+        throw std::underflow_error("Stack is empty");
+    }
+    return items[top];
+}
@@ -0,0 +1,66 @@
+#include "../include/WorkStealingDeque.h"
+
+// Orderings follow Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory
+// Models" (PPoPP 2013), with the seq_cst fences folded into the bottom store and top loads they separate.
+
+WorkStealingDeque::WorkStealingDeque() {
+    rings.push_back(std::make_unique<Ring>(MIN_CAPACITY));
+    ring.store(rings.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::Ring* WorkStealingDeque::grow(Ring* old, int64_t top, int64_t bottom) {
+    rings.reserve(rings.size() + 1);
+    auto bigger = std::make_unique<Ring>(old->capacity * 2);
+    for (int64_t i = top; i < bottom; ++i) {
+        bigger->at(i).store(old->at(i).load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    rings.push_back(std::move(bigger));
+    Ring* current = rings.back().get();
+    ring.store(current, std::memory_order_release);
+    return current;
+}
+
+void WorkStealingDeque::push(Task* task) {
+    const int64_t b = bottom.load(std::memory_order_relaxed);
+    const int64_t t = top.load(std::memory_order_acquire);
+    Ring* current = ring.load(std::memory_order_relaxed);
+    if (b - t >= current->capacity) current = grow(current, t, b);
+    current->at(b).store(task, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_release);
+}
+
+Task* WorkStealingDeque::pop() {
+    const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    Ring* current = ring.load(std::memory_order_relaxed);
+    // claim the bottom slot before looking at top, so a thief cannot take it unnoticed
+    bottom.store(b, std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_seq_cst);
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Task* task = current->at(b).load(std::memory_order_relaxed);
+    if (t == b) {
+        // last task: race the thieves for it
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            task = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+Task* WorkStealingDeque::steal() {
+    int64_t t = top.load(std::memory_order_seq_cst);
+    const int64_t b = bottom.load(std::memory_order_seq_cst);
+    if (t >= b) return nullptr;
+    Task* task = ring.load(std::memory_order_acquire)->at(t).load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return task;
+}
+
+bool WorkStealingDeque::isEmpty() const {
+    return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "../include/ForkJoinPool.h"
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Fib : Task {
+    int n;
+    long long result = 0;
+
+    explicit Fib(int n) : n(n) {}
+    void run() override {
+        if (n < 2) {
+            result = n;
+            return;
+        }
+        Fib first(n - 1), second(n - 2);
+        ForkJoinPool::fork(first);
+        second.run();
+        ForkJoinPool::join(first);
+        result = first.result + second.result;
+    }
+};
+
+struct QuickSort : Task {
+    int* first;
+    int* last;
+
+    QuickSort(int* first, int* last) : first(first), last(last) {}
+    void run() override {
+        if (last - first < 64) {
+            std::sort(first, last);
+            return;
+        }
+        const int pivot = first[(last - first) / 2];
+        int* middle = std::partition(first, last, [pivot](int x) { return x < pivot; });
+        int* upper = std::partition(middle, last, [pivot](int x) { return x == pivot; });
+        QuickSort left(first, middle), right(upper, last);
+        ForkJoinPool::fork(left);
+        right.run();
+        ForkJoinPool::join(left);
+    }
+};
+} // namespace
+
+TEST(ForkJoinPool, ComputesFib) {
+    ForkJoinPool pool(4);
+    EXPECT_EQ(4u, pool.size());
+    Fib fib(22);
+    pool.invoke(fib);
+    EXPECT_TRUE(fib.isDone());
+    EXPECT_EQ(17711, fib.result);
+}
+
+TEST(ForkJoinPool, SortsInParallel) {
+    std::vector<int> values(100000);
+    std::mt19937 random(7);
+    for (int& value : values) value = static_cast<int>(random() % 1000);
+    ForkJoinPool pool(3);
+    QuickSort sort(values.data(), values.data() + values.size());
+    pool.invoke(sort);
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST(ForkJoinPool, ForkOutsideAPoolRunsSequentially) {
+    Fib fib(15);
+    ForkJoinPool::fork(fib);
+    EXPECT_TRUE(fib.isDone());
+    ForkJoinPool::join(fib);
+    EXPECT_EQ(610, fib.result);
+}
+
+TEST(ForkJoinPool, InvokeFromSeveralThreads) {
+    ForkJoinPool pool(2);
+    Fib fibs[] = {Fib(18), Fib(19), Fib(20), Fib(21)};
+    std::vector<std::thread> callers;
+    for (auto& fib : fibs) callers.emplace_back([&pool, &fib] { pool.invoke(fib); });
+    for (auto& caller : callers) caller.join();
+    EXPECT_EQ(2584, fibs[0].result);
+    EXPECT_EQ(10946, fibs[3].result);
+}
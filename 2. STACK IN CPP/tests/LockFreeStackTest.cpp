@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "../include/LockFreeStack.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(LockFreeStack, LifoOrderOnOneThread) {
+    LockFreeStack stack;
+    EXPECT_TRUE(stack.isEmpty());
+    for (int i = 0; i < 1000; ++i) stack.push(i);
+    EXPECT_FALSE(stack.isEmpty());
+    for (int i = 999; i >= 0; --i) EXPECT_EQ(i, stack.pop());
+    EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(LockFreeStack, EmptyPop) {
+    LockFreeStack stack;
+    int item = 7;
+    EXPECT_FALSE(stack.tryPop(item));
+    EXPECT_EQ(7, item);
+    EXPECT_THROW(stack.pop(), std::underflow_error);
+}
+
+TEST(LockFreeStack, DestructorFreesRemainingNodes) {
+    auto* stack = new LockFreeStack;
+    for (int i = 0; i < 100; ++i) stack->push(i);
+    delete stack;
+}
+
+// producers push disjoint ranges while consumers pop; every value must come out exactly once
+TEST(LockFreeStack, ConcurrentPushAndPopLoseNothing) {
+    const int threads = 4, perThread = 50000;
+    LockFreeStack stack;
+    std::vector<std::atomic<int>> seen(threads * perThread);
+    std::atomic<int> popped{0};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < perThread; ++i) stack.push(t * perThread + i);
+        });
+        workers.emplace_back([&] {
+            int item;
+            while (popped.load() < threads * perThread) {
+                if (stack.tryPop(item)) {
+                    seen[item].fetch_add(1);
+                    popped.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    EXPECT_TRUE(stack.isEmpty());
+    for (size_t i = 0; i < seen.size(); ++i) ASSERT_EQ(1, seen[i].load()) << "value " << i;
+}
+
+// every thread alternates push and pop, keeping the head hot; the multiset of values must be preserved
+TEST(LockFreeStack, ConcurrentPushPopPairs) {
+    const int threads = 8, rounds = 20000;
+    LockFreeStack stack;
+    for (int i = 0; i < threads; ++i) stack.push(i);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < rounds; ++i) {
+                int item;
+                if (stack.tryPop(item)) stack.push(item);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    int item, sum = 0;
+    while (stack.tryPop(item)) sum += item;
+    EXPECT_EQ(threads * (threads - 1) / 2, sum);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "../include/MappedStack.h"
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+TEST(MappedStack, LifoOrderAcrossCommitSteps) {
+    MappedStack stack;
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_EQ(0u, stack.getCommittedBytes());
+    const int n = 3 * MappedStack::COMMIT_STEP / sizeof(int) + 5;
+    for (int i = 0; i < n; ++i) stack.push(i);
+    EXPECT_EQ(size_t(n), stack.size());
+    EXPECT_EQ(4 * MappedStack::COMMIT_STEP, stack.getCommittedBytes());
+    EXPECT_EQ(n - 1, stack.peek());
+    for (int i = n - 1; i >= 0; --i) ASSERT_EQ(i, stack.pop());
+    EXPECT_THROW(stack.pop(), std::underflow_error);
+    EXPECT_THROW(stack.peek(), std::underflow_error);
+}
+
+TEST(MappedStack, ReleasesMemoryPastTheThreshold) {
+    const size_t step = MappedStack::COMMIT_STEP;
+    MappedStack stack(size_t(1) << 26, false, step);
+    const size_t perStep = step / sizeof(int);
+    for (size_t i = 0; i < 10 * perStep; ++i) stack.push(static_cast<int>(i));
+    EXPECT_EQ(10 * step, stack.getCommittedBytes());
+
+    // within 2 * threshold of the committed end nothing is released
+    for (size_t i = 0; i < 2 * perStep; ++i) stack.pop();
+    EXPECT_EQ(10 * step, stack.getCommittedBytes());
+    stack.pop();
+    EXPECT_EQ(9 * step, stack.getCommittedBytes());
+
+    while (stack.size() > 1) stack.pop();
+    EXPECT_EQ(2 * step, stack.getCommittedBytes());
+    // released pages come back zeroed, committed again on the next push
+    for (size_t i = 1; i < 5 * perStep; ++i) stack.push(static_cast<int>(i));
+    for (size_t i = 5 * perStep - 1; i > 0; --i) ASSERT_EQ(static_cast<int>(i), stack.pop());
+    EXPECT_EQ(0, stack.pop());
+}
+
+TEST(MappedStack, FullStackThrowsBadAlloc) {
+    MappedStack stack(10);
+    EXPECT_EQ(10u, stack.getCapacity());
+    for (int i = 0; i < 10; ++i) stack.push(i);
+    EXPECT_THROW(stack.push(10), std::bad_alloc);
+    EXPECT_EQ(9, stack.pop());
+}
+
+TEST(MappedStack, MovesTransferTheMapping) {
+    MappedStack stack(1000, true);
+    stack.push(1);
+    MappedStack moved(std::move(stack));
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_THROW(stack.push(2), std::bad_alloc);
+    stack = std::move(moved);
+    EXPECT_EQ(1, stack.pop());
+}
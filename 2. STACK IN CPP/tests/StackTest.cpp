@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 #include "../include/Stack.h"
 #include <climits>
+#include <iterator>
+#include <numeric>
+#include <sstream>
 #include <stdexcept>  
+#include <vector>
 
 TEST(InitializeStack, CreatesEmptyStack) {
     Stack stack;
@@ -75,3 +79,71 @@ TEST(Exceptions, PopOnEmptyThrowsUnderflow) {
 }
 
 
+
+TEST(BulkOperations, PushRangeThenPopNRoundTrips) {
+    Stack stack;
+    stack.push(-1);
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    stack.pushRange(values.begin(), values.end());
+    EXPECT_EQ(1001u, stack.size());
+    EXPECT_EQ(999, stack.peek());
+
+    std::vector<int> out(1000);
+    EXPECT_EQ(out.end(), stack.popN(out.size(), out.begin()));
+    EXPECT_EQ(values, out);
+    EXPECT_EQ(1u, stack.size());
+    EXPECT_EQ(-1, stack.pop());
+}
+
+TEST(BulkOperations, BulkOrderMatchesSinglePops) {
+    Stack stack;
+    const int values[] = {1, 2, 3, 4, 5};
+    stack.pushRange(std::begin(values), std::end(values));
+    int top[2];
+    stack.peekN(2, top);
+    EXPECT_EQ(4, top[0]);
+    EXPECT_EQ(5, top[1]);
+    EXPECT_EQ(5u, stack.size());
+    EXPECT_EQ(5, stack.pop());
+    EXPECT_EQ(4, stack.pop());
+}
+
+TEST(BulkOperations, InputIteratorsAndEmptyRanges) {
+    Stack stack;
+    std::istringstream in("7 8 9");
+    stack.pushRange(std::istream_iterator<int>(in), std::istream_iterator<int>());
+    stack.pushRange(std::begin(""), std::begin(""));
+    EXPECT_EQ(3u, stack.size());
+    std::vector<int> out;
+    stack.popN(0, std::back_inserter(out));
+    stack.popN(3, std::back_inserter(out));
+    EXPECT_EQ((std::vector<int>{7, 8, 9}), out);
+}
+
+TEST(BulkOperations, ShortStackThrowsAndKeepsItems) {
+    Stack stack;
+    stack.push(1);
+    int out[2];
+    EXPECT_THROW(stack.popN(2, out), std::underflow_error);
+    EXPECT_THROW(stack.peekN(2, out), std::underflow_error);
+    EXPECT_EQ(1u, stack.size());
+    EXPECT_EQ(1, stack.pop());
+    EXPECT_THROW(stack.peek(), std::underflow_error);
+}
+
+TEST(Capacity, ReserveAndShrinkToFit) {
+    Stack stack;
+    stack.reserve(100);
+    EXPECT_EQ(100u, stack.getCapacity());
+    for (int i = 0; i < 100; ++i) stack.push(i);
+    EXPECT_EQ(100u, stack.getCapacity());
+    stack.reserve(10);
+    EXPECT_EQ(100u, stack.getCapacity());
+
+    int out[97];
+    stack.popN(97, out);
+    stack.shrinkToFit();
+    EXPECT_EQ(8u, stack.getCapacity());
+    EXPECT_EQ(2, stack.pop());
+}
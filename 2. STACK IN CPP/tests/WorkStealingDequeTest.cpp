@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "../include/ForkJoinPool.h"
+#include "../include/WorkStealingDeque.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// counts how often it was taken out of a deque
+struct CountedTask : Task {
+    std::atomic<int> taken{0};
+    void run() override {}
+};
+
+TEST(WorkStealingDeque, OwnerPopsNewestThiefStealsOldest) {
+    WorkStealingDeque deque;
+    std::vector<CountedTask> tasks(3);
+    EXPECT_TRUE(deque.isEmpty());
+    EXPECT_EQ(nullptr, deque.pop());
+    EXPECT_EQ(nullptr, deque.steal());
+    for (auto& task : tasks) deque.push(&task);
+    EXPECT_EQ(&tasks[2], deque.pop());
+    EXPECT_EQ(&tasks[0], deque.steal());
+    EXPECT_EQ(&tasks[1], deque.pop());
+    EXPECT_EQ(nullptr, deque.pop());
+    EXPECT_TRUE(deque.isEmpty());
+}
+
+TEST(WorkStealingDeque, GrowsWithAWrappedLiveRange) {
+    WorkStealingDeque deque;
+    std::vector<CountedTask> tasks(1000);
+    // move top past the start of the ring before it has to grow
+    for (int i = 0; i < 5; ++i) deque.push(&tasks[i]);
+    for (int i = 0; i < 5; ++i) EXPECT_EQ(&tasks[i], deque.steal());
+    for (auto& task : tasks) deque.push(&task);
+    for (int i = 0; i < 500; ++i) EXPECT_EQ(&tasks[i], deque.steal());
+    for (int i = 999; i >= 500; --i) EXPECT_EQ(&tasks[i], deque.pop());
+    EXPECT_EQ(nullptr, deque.pop());
+}
+
+// the owner pushes and pops while thieves steal; every task must be taken exactly once
+TEST(WorkStealingDeque, ConcurrentStealsTakeEveryTaskOnce) {
+    const int count = 200000, thieves = 3;
+    WorkStealingDeque deque;
+    std::vector<CountedTask> tasks(count);
+    std::atomic<int> taken{0};
+    auto take = [&](Task* task) {
+        static_cast<CountedTask*>(task)->taken.fetch_add(1);
+        taken.fetch_add(1);
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thieves; ++t) {
+        threads.emplace_back([&] {
+            while (taken.load() < count) {
+                if (Task* task = deque.steal()) take(task);
+            }
+        });
+    }
+    for (int i = 0; i < count; ++i) {
+        deque.push(&tasks[i]);
+        if (i % 3 == 0) {
+            if (Task* task = deque.pop()) take(task);
+        }
+    }
+    while (Task* task = deque.pop()) take(task);
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(count, taken.load());
+    for (const auto& task : tasks) EXPECT_EQ(1, task.taken.load());
+}
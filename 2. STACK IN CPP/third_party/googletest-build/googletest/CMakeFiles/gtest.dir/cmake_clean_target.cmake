@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "/root/repo/2. STACK IN CPP/_gate_build/lib/libgtest.a"
+)
@@ -0,0 +1,10 @@
+#include <gtest/gtest.h>
+#include "Stack.h"
+#include "StackTracingChecks.h"
+
+// MIN_CAPACITY is 8 and push() doubles
+TEST(StackTracing, CountsOperationsAndGrowth) { expectPushPopTrace<Stack>({8, 16, 32, 64, 128}); }
+
+TEST(StackTracing, BulkOperationsAndGlobalTotals) { expectBulkAndGlobalTrace<Stack>(); }
+
+TEST(StackTracing, CopiesTraceSeparately) { expectCopiesTraceSeparately<Stack>(); }
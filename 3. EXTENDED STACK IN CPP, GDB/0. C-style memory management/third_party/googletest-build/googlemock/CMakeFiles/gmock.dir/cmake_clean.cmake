@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/3. EXTENDED STACK IN CPP, GDB/0. C-style memory management/_gate_build/bin/libgmock.pdb"
+  "/root/repo/3. EXTENDED STACK IN CPP, GDB/0. C-style memory management/_gate_build/lib/libgmock.a"
+  "CMakeFiles/gmock.dir/src/gmock-all.cc.o"
+  "CMakeFiles/gmock.dir/src/gmock-all.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gmock.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
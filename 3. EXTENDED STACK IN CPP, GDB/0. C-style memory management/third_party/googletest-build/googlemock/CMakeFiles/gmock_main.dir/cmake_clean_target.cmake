@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "/root/repo/3. EXTENDED STACK IN CPP, GDB/0. C-style memory management/_gate_build/lib/libgmock_main.a"
+)
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/3. EXTENDED STACK IN CPP, GDB/0. C-style memory management/_gate_build/bin/libgtest.pdb"
+  "/root/repo/3. EXTENDED STACK IN CPP, GDB/0. C-style memory management/_gate_build/lib/libgtest.a"
+  "CMakeFiles/gtest.dir/src/gtest-all.cc.o"
+  "CMakeFiles/gtest.dir/src/gtest-all.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gtest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -29,6 +29,39 @@ Stack& Stack::operator=(const Stack& toCopy) {
     return *this;
 }
 
+void Stack::reallocate(int newCapacity) {
+    auto newItems = std::make_unique<int[]>(newCapacity);
+    std::copy(items.get(), items.get() + (top + 1), newItems.get());
+    items = std::move(newItems);
+    capacity = newCapacity;
+}
+
+void Stack::reserve(size_t newCapacity) {
+    if (newCapacity > static_cast<size_t>(capacity)) {
+        reallocate(static_cast<int>(newCapacity));
+        STACK_TRACE(growth(capacity, size() * sizeof(int)));
+    }
+}
+
+void Stack::shrinkToFit() {
+    const int newCapacity = std::max(top + 1, MIN_CAPACITY);
+    if (newCapacity < capacity) reallocate(newCapacity);
+}
+
+void Stack::growFor(size_t n) {
+    const size_t needed = size() + n;
+    if (needed > static_cast<size_t>(capacity)) {
+        reallocate(static_cast<int>(std::max(needed, 2 * static_cast<size_t>(capacity))));
+        STACK_TRACE(growth(capacity, size() * sizeof(int)));
+    }
+}
+
+void Stack::requireItems(size_t n) const {
+    if (n > size()) {
+        throw std::runtime_error("Stack has fewer items than requested");
+    }
+}
+
 void Stack::push(int item) {
     if (top + 1 >= capacity) {
         int newCapacity = capacity * 2;
@@ -38,18 +71,28 @@ void Stack::push(int item) {
 
         items = std::move(newItems);
         capacity = newCapacity;
+        STACK_TRACE(growth(capacity, size() * sizeof(int)));
     }
 
     items[++top] = item;
+    STACK_TRACE(push(1, size()));
 }
 
 int Stack::pop() {
     if (isEmpty()) {
         throw std::runtime_error("Stack is empty");
     }
+    STACK_TRACE(pop(1));
     return items[top--];
 }
 
 bool Stack::isEmpty() const {
     return top == -1;
 }
+
+int Stack::peek() const {
+    if (isEmpty()) {
+        throw std::runtime_error("Stack is empty");
+    }
+    return items[top];
+}
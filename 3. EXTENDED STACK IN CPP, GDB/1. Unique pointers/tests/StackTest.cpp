@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include "../include/Stack.h"
 #include <climits>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
 
 TEST(InitializeStack, CreatesEmptyStack) {
     Stack stack;
@@ -164,3 +169,56 @@ TEST(AssignmentOperator, Chaining) {
     EXPECT_TRUE(stack2.isEmpty());
     EXPECT_TRUE(stack3.isEmpty());
 }
+
+TEST(BulkOperations, PushRangeThenPopNRoundTrips) {
+    Stack stack;
+    stack.push(-1);
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    stack.pushRange(values.begin(), values.end());
+    EXPECT_EQ(1001u, stack.size());
+    EXPECT_EQ(999, stack.peek());
+
+    std::vector<int> out(1000);
+    EXPECT_EQ(out.end(), stack.popN(out.size(), out.begin()));
+    EXPECT_EQ(values, out);
+    EXPECT_EQ(1u, stack.size());
+    EXPECT_EQ(-1, stack.pop());
+}
+
+TEST(BulkOperations, BulkOrderMatchesSinglePops) {
+    Stack stack;
+    std::istringstream in("1 2 3 4 5");
+    stack.pushRange(std::istream_iterator<int>(in), std::istream_iterator<int>());
+    int top[2];
+    stack.peekN(2, top);
+    EXPECT_EQ(4, top[0]);
+    EXPECT_EQ(5, top[1]);
+    EXPECT_EQ(5u, stack.size());
+    EXPECT_EQ(5, stack.pop());
+    EXPECT_EQ(4, stack.pop());
+}
+
+TEST(BulkOperations, ShortStackThrowsAndKeepsItems) {
+    Stack stack;
+    stack.push(1);
+    int out[2];
+    EXPECT_THROW(stack.popN(2, out), std::runtime_error);
+    EXPECT_THROW(stack.peekN(2, out), std::runtime_error);
+    EXPECT_EQ(1, stack.pop());
+    EXPECT_THROW(stack.peek(), std::runtime_error);
+}
+
+TEST(Capacity, ReserveAndShrinkToFit) {
+    Stack stack;
+    stack.reserve(100);
+    EXPECT_EQ(100u, stack.getCapacity());
+    for (int i = 0; i < 100; ++i) stack.push(i);
+    EXPECT_EQ(100u, stack.getCapacity());
+
+    int out[97];
+    stack.popN(97, out);
+    stack.shrinkToFit();
+    EXPECT_EQ(8u, stack.getCapacity());
+    EXPECT_EQ(2, stack.pop());
+}
@@ -1,12 +1,26 @@
 #pragma once
 #include <vector>
 #include <algorithm>
+#include <cstddef>
+#include "StackStats.h"
 
 class Stack {
 private:
     std::vector<int> items;
     static constexpr int MIN_CAPACITY = 8;
 
+#ifdef STACK_TRACING
+    StackTracer tracer;
+#endif
+
+    // records a growth when the last insertion reallocated the vector
+    void traceGrowth(size_t oldCapacity, [[maybe_unused]] size_t oldSize) {
+        if (items.capacity() != oldCapacity) STACK_TRACE(growth(items.capacity(), oldSize * sizeof(int)));
+    }
+
+    // can throw exception: std::runtime_error when there are fewer than n items
+    void requireItems(size_t n) const;
+
 public:
     Stack();
     Stack(const Stack& toCopy) = default;
@@ -17,4 +31,47 @@ public:
     void push(int item);
     int pop();
     bool isEmpty() const;
+
+    // can throw exception: std::runtime_error when the stack is empty
+    int peek() const;
+    size_t size() const { return items.size(); }
+    size_t getCapacity() const { return items.capacity(); }
+
+    void reserve(size_t newCapacity) {
+        const size_t oldCapacity = items.capacity();
+        items.reserve(newCapacity);
+        traceGrowth(oldCapacity, items.size());
+    }
+    void shrinkToFit() { items.shrink_to_fit(); }
+
+#ifdef STACK_TRACING
+    const StackStats& getStats() const { return tracer.getStats(); }
+#endif
+
+    // Bulk transfers: vector::insert sizes forward ranges once, and std::copy becomes memmove.
+    // out receives the top n items bottom to top, the order pushRange takes them in, so
+    // pushRange(out, out + n) after popN(n, out) restores the stack.
+
+    template <typename InputIt>
+    void pushRange(InputIt first, InputIt last) {
+        const size_t oldCapacity = items.capacity();
+        const size_t oldSize = items.size();
+        items.insert(items.end(), first, last);
+        traceGrowth(oldCapacity, oldSize);
+        STACK_TRACE(push(items.size() - oldSize, items.size()));
+    }
+    // can throw exception: std::runtime_error when there are fewer than n items; nothing is popped then
+    template <typename OutputIt>
+    OutputIt popN(size_t n, OutputIt out) {
+        out = peekN(n, out);
+        items.resize(items.size() - n);
+        STACK_TRACE(pop(n));
+        return out;
+    }
+    // can throw exception: std::runtime_error when there are fewer than n items
+    template <typename OutputIt>
+    OutputIt peekN(size_t n, OutputIt out) const {
+        requireItems(n);
+        return std::copy(items.end() - n, items.end(), out);
+    }
 };
@@ -7,7 +7,10 @@ Stack::Stack() {
 }
 
 void Stack::push(int item) {
+    const size_t oldCapacity = items.capacity();
     items.push_back(item);
+    traceGrowth(oldCapacity, items.size() - 1);
+    STACK_TRACE(push(1, items.size()));
 }
 
 int Stack::pop() {
@@ -16,6 +19,7 @@ int Stack::pop() {
     }
     int value = items.back();
     items.pop_back();
+    STACK_TRACE(pop(1));
     return value;
 }
 
@@ -23,3 +27,16 @@ bool Stack::isEmpty() const {
     return items.empty();
 }
 
+int Stack::peek() const {
+    if (isEmpty()) {
+        throw std::runtime_error("Stack is empty");
+    }
+    return items.back();
+}
+
+void Stack::requireItems(size_t n) const {
+    if (n > items.size()) {
+        throw std::runtime_error("Stack has fewer items than requested");
+    }
+}
+
@@ -0,0 +1,10 @@
+#include <gtest/gtest.h>
+#include "../include/Stack.h"
+#include "StackTracingChecks.h"
+
+// the constructor reserves 8 and push_back doubles
+TEST(StackTracing, CountsOperationsAndGrowth) { expectPushPopTrace<Stack>({8, 16, 32, 64, 128}); }
+
+TEST(StackTracing, BulkOperationsAndGlobalTotals) { expectBulkAndGlobalTrace<Stack>(); }
+
+TEST(StackTracing, CopiesTraceSeparately) { expectCopiesTraceSeparately<Stack>(); }
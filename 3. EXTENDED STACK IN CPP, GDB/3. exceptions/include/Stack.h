@@ -1,4 +1,10 @@
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include "StackStats.h"
+
 class Stack
 {
   public:
@@ -12,9 +18,74 @@ class Stack
     int pop();
     bool isEmpty() const;
 
+    // can throw exception: std::underflow_error when the stack is empty
+    int peek() const;
+    size_t size() const { return top + 1; }
+    size_t getCapacity() const { return capacity; }
+
+    // can throw std::bad_alloc
+    void reserve(size_t newCapacity);
+    // releases unused capacity down to max(size(), MIN_CAPACITY)
+    void shrinkToFit();
+
+#ifdef STACK_TRACING
+    const StackStats& getStats() const { return tracer.getStats(); }
+#endif
+
+    // Bulk transfers check the capacity once and copy with std::copy (memmove for contiguous ranges).
+    // out receives the top n items bottom to top, the order pushRange takes them in, so
+    // pushRange(out, out + n) after popN(n, out) restores the stack.
+
+    // can throw std::bad_alloc
+    template <typename InputIt>
+    void pushRange(InputIt first, InputIt last);
+    // can throw exception: std::underflow_error when there are fewer than n items; nothing is popped then
+    template <typename OutputIt>
+    OutputIt popN(size_t n, OutputIt out);
+    // can throw exception: std::underflow_error when there are fewer than n items
+    template <typename OutputIt>
+    OutputIt peekN(size_t n, OutputIt out) const;
+
   private:
     int* items;
     int capacity;
     int top;
     static constexpr int MIN_CAPACITY = 1;
-};
\ No newline at end of file
+
+#ifdef STACK_TRACING
+    StackTracer tracer;
+#endif
+
+    // makes room for n more items with one reallocation, at least doubling the capacity
+    void growFor(size_t n);
+    // can throw exception: std::underflow_error when there are fewer than n items
+    void requireItems(size_t n) const;
+};
+
+template <typename InputIt>
+void Stack::pushRange(InputIt first, InputIt last) {
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+        const size_t n = std::distance(first, last);
+        growFor(n);
+        std::copy(first, last, items + top + 1);
+        top += static_cast<int>(n);
+        STACK_TRACE(push(n, size()));
+    } else {
+        for (; first != last; ++first) push(*first);
+    }
+}
+
+template <typename OutputIt>
+OutputIt Stack::popN(size_t n, OutputIt out) {
+    requireItems(n);
+    top -= static_cast<int>(n);
+    STACK_TRACE(pop(n));
+    return std::copy(items + top + 1, items + top + 1 + n, out);
+}
+
+template <typename OutputIt>
+OutputIt Stack::peekN(size_t n, OutputIt out) const {
+    requireItems(n);
+    return std::copy(items + top + 1 - n, items + top + 1, out);
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include "Stack.h"
+#include <gtest/gtest.h>
+#include "StackTracingChecks.h"
+
+// MIN_CAPACITY is 1 and push() doubles
+TEST(StackTracing, CountsOperationsAndGrowth) { expectPushPopTrace<Stack>({1, 2, 4, 8, 16, 32, 64, 128}); }
+
+TEST(StackTracing, BulkOperationsAndGlobalTotals) { expectBulkAndGlobalTrace<Stack>(); }
+
+TEST(StackTracing, CopiesTraceSeparately) { expectCopiesTraceSeparately<Stack>(); }
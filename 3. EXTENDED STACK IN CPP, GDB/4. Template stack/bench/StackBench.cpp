@@ -0,0 +1,139 @@
+// Stack<T>, SegmentedStack<T>, SmallStack<T, N> and SnapshotStack<T> against std::stack over std::vector and std::deque.
+// Run with --benchmark_format=json (or csv) for machine-readable output.
+#include <benchmark/benchmark.h>
+#include "SegmentedStack.h"
+#include "SmallStack.h"
+#include "SnapshotStack.h"
+#include "Stack.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <stack>
+#include <string>
+#include <vector>
+
+template <typename T>
+using VectorStack = std::stack<T, std::vector<T>>;
+template <typename T>
+using DequeStack = std::stack<T, std::deque<T>>;
+
+// 32 trivially copyable bytes, relocated with memcpy by Stack<T>
+struct Task {
+    long long id, parent, priority, deadline;
+};
+
+template <typename T>
+static T makeItem(int i);
+template <>
+int makeItem<int>(int i) { return i; }
+template <>
+Task makeItem<Task>(int i) { return {i, i - 1, i % 7, i * 3LL}; }
+template <>
+std::string makeItem<std::string>(int i) { return std::string(24 + i % 8, 'x'); }
+template <>
+std::unique_ptr<int> makeItem<std::unique_ptr<int>>(int i) { return std::make_unique<int>(i); }
+
+// the std::stack adaptors split pop into top() and pop()
+template <typename T>
+static T popFrom(Stack<T>& stack) { return stack.pop(); }
+template <typename T>
+static T popFrom(SegmentedStack<T>& stack) { return stack.pop(); }
+template <typename T, size_t N>
+static T popFrom(SmallStack<T, N>& stack) { return stack.pop(); }
+template <typename T, typename Container>
+static T popFrom(std::stack<T, Container>& stack) {
+    T item = std::move(stack.top());
+    stack.pop();
+    return item;
+}
+
+// range(0) pushes into a fresh stack, growth included, then range(0) pops
+template <typename StackType, typename T>
+static void BM_PushPop(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        StackType stack;
+        for (int i = 0; i < n; ++i) stack.push(makeItem<T>(i));
+        for (int i = 0; i < n; ++i) benchmark::DoNotOptimize(popFrom(stack));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// range(0) pushes into a fresh stack, reporting the slowest single push; doubling stacks pay for a full
+// copy on their last growth, SegmentedStack at most for one chunk allocation
+template <typename StackType, typename T>
+static void BM_PushLatency(benchmark::State& state) {
+    using Clock = std::chrono::steady_clock;
+    const int n = static_cast<int>(state.range(0));
+    Clock::duration slowest{};
+    for (auto _ : state) {
+        StackType stack;
+        for (int i = 0; i < n; ++i) {
+            const T item = makeItem<T>(i);
+            const auto start = Clock::now();
+            stack.push(item);
+            slowest = std::max(slowest, Clock::now() - start);
+        }
+    }
+    state.counters["max_push_us"] = std::chrono::duration<double, std::micro>(slowest).count();
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// a short-lived stack per iteration, the way a recursive-descent evaluator uses them
+template <typename StackType>
+static void BM_ShortLived(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        StackType stack;
+        for (int i = 0; i < n; ++i) stack.push(i);
+        for (int i = 0; i < n; ++i) benchmark::DoNotOptimize(popFrom(stack));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// one backtracking branch: copy a stack of range(0) items, then push and pop a few on the copy
+template <typename StackType>
+static void BM_Branch(benchmark::State& state) {
+    StackType stack;
+    for (int i = 0; i < state.range(0); ++i) stack.push(i);
+    for (auto _ : state) {
+        StackType branch(stack);
+        branch.push(-1);
+        branch.push(-2);
+        benchmark::DoNotOptimize(branch.pop());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_PushPop, Stack<int>, int)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_PushPop, VectorStack<int>, int)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_PushPop, DequeStack<int>, int)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_PushPop, SegmentedStack<int>, int)->Arg(1 << 10)->Arg(1 << 20);
+
+BENCHMARK_TEMPLATE(BM_PushPop, Stack<Task>, Task)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_PushPop, VectorStack<Task>, Task)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_PushPop, DequeStack<Task>, Task)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_PushPop, SegmentedStack<Task>, Task)->Arg(1 << 10)->Arg(1 << 20);
+
+BENCHMARK_TEMPLATE(BM_PushPop, Stack<std::string>, std::string)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_PushPop, VectorStack<std::string>, std::string)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_PushPop, DequeStack<std::string>, std::string)->Arg(1 << 10)->Arg(1 << 16);
+
+using Owner = std::unique_ptr<int>;
+BENCHMARK_TEMPLATE(BM_PushPop, Stack<Owner>, Owner)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_PushPop, VectorStack<Owner>, Owner)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_PushPop, DequeStack<Owner>, Owner)->Arg(1 << 10)->Arg(1 << 16);
+
+BENCHMARK_TEMPLATE(BM_PushLatency, Stack<Task>, Task)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PushLatency, VectorStack<Task>, Task)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PushLatency, SegmentedStack<Task>, Task)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_ShortLived, Stack<int>)->Arg(4)->Arg(12);
+BENCHMARK_TEMPLATE(BM_ShortLived, VectorStack<int>)->Arg(4)->Arg(12);
+using InlineStack = SmallStack<int, 16>;
+BENCHMARK_TEMPLATE(BM_ShortLived, InlineStack)->Arg(4)->Arg(12);
+
+BENCHMARK_TEMPLATE(BM_Branch, Stack<int>)->Arg(1 << 6)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_Branch, SnapshotStack<int>)->Arg(1 << 6)->Arg(1 << 12)->Arg(1 << 18);
+
+BENCHMARK_MAIN();
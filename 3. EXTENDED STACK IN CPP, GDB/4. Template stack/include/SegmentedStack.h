@@ -0,0 +1,181 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Stack built from a linked list of fixed-size chunks. Growth links a new chunk instead of reallocating,
+// so no element is ever moved or copied after it is pushed: push is O(1) in the worst case, references
+// to elements stay valid until the element is popped, and the stack never holds two copies of its data.
+//
+// The most recently emptied chunk is kept as a spare, so pushing and popping across a chunk boundary does
+// not allocate and free on every call.
+template <typename T, size_t ChunkCapacity = std::max<size_t>(1, (64 * 1024 - sizeof(void*)) / sizeof(T))>
+class SegmentedStack {
+private:
+    struct Chunk {
+        Chunk* previous;
+        alignas(T) unsigned char storage[ChunkCapacity * sizeof(T)];
+
+        void* raw(size_t i) { return storage + i * sizeof(T); }
+        T* slot(size_t i) { return std::launder(reinterpret_cast<T*>(raw(i))); }
+    };
+
+    Chunk* top = nullptr;
+    // elements in the top chunk; every chunk below it is full
+    size_t topCount = 0;
+    size_t count = 0;
+    Chunk* spare = nullptr;
+
+    Chunk* takeChunk() {
+        if (nullptr == spare) return new Chunk;
+        Chunk* chunk = spare;
+        spare = nullptr;
+        return chunk;
+    }
+
+    void giveBack(Chunk* chunk) {
+        if (nullptr == spare)
+            spare = chunk;
+        else
+            delete chunk;
+    }
+
+    // builds the element in the next chunk before linking it, so a throwing constructor changes nothing
+    template <typename... Args>
+    T& emplaceInNewChunk(Args&&... args) {
+        Chunk* chunk = takeChunk();
+        T* item;
+        try {
+            item = ::new (chunk->raw(0)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            giveBack(chunk);
+            throw;
+        }
+        chunk->previous = top;
+        top = chunk;
+        topCount = 1;
+        ++count;
+        return *item;
+    }
+
+    void releaseAll() noexcept {
+        clear();
+        delete spare;
+        spare = nullptr;
+    }
+
+public:
+    SegmentedStack() = default;
+
+    // can throw exception: whatever T's copy constructor throws or std::bad_alloc
+    SegmentedStack(const SegmentedStack& toCopy) {
+        std::vector<Chunk*> chunks;
+        for (Chunk* chunk = toCopy.top; nullptr != chunk; chunk = chunk->previous) chunks.push_back(chunk);
+        try {
+            for (auto it = chunks.rbegin(); it != chunks.rend(); ++it) {
+                const size_t n = *it == toCopy.top ? toCopy.topCount : ChunkCapacity;
+                for (size_t i = 0; i < n; ++i) push(*(*it)->slot(i));
+            }
+        } catch (...) {
+            releaseAll();
+            throw;
+        }
+    }
+
+    SegmentedStack(SegmentedStack&& toMove) noexcept
+        : top(toMove.top), topCount(toMove.topCount), count(toMove.count), spare(toMove.spare) {
+        toMove.top = nullptr;
+        toMove.topCount = 0;
+        toMove.count = 0;
+        toMove.spare = nullptr;
+    }
+
+    // copy and swap: the stack is unchanged when copying throws
+    SegmentedStack& operator=(const SegmentedStack& toCopy) {
+        if (this != &toCopy) {
+            SegmentedStack copy(toCopy);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SegmentedStack& operator=(SegmentedStack&& toMove) noexcept {
+        if (this != &toMove) {
+            releaseAll();
+            std::swap(top, toMove.top);
+            std::swap(topCount, toMove.topCount);
+            std::swap(count, toMove.count);
+            std::swap(spare, toMove.spare);
+        }
+        return *this;
+    }
+
+    ~SegmentedStack() { releaseAll(); }
+
+    void swap(SegmentedStack& other) noexcept {
+        std::swap(top, other.top);
+        std::swap(topCount, other.topCount);
+        std::swap(count, other.count);
+        std::swap(spare, other.spare);
+    }
+
+    // can throw exception: whatever T's constructor throws or std::bad_alloc; the stack is then unchanged
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if (nullptr == top || topCount == ChunkCapacity) return emplaceInNewChunk(std::forward<Args>(args)...);
+        T* item = ::new (top->raw(topCount)) T(std::forward<Args>(args)...);
+        ++topCount;
+        ++count;
+        return *item;
+    }
+
+    void push(const T& item) { emplace(item); }
+    void push(T&& item) { emplace(std::move(item)); }
+
+    // can throw exception: std::underflow_error when the stack is empty
+    T pop() {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack is empty");
+        }
+        T* slot = top->slot(topCount - 1);
+        T item(std::move(*slot));
+        slot->~T();
+        --count;
+        if (--topCount == 0) {
+            Chunk* emptied = top;
+            top = emptied->previous;
+            topCount = nullptr == top ? 0 : ChunkCapacity;
+            giveBack(emptied);
+        }
+        return item;
+    }
+
+    // can throw exception: std::underflow_error when the stack is empty
+    T& peek() {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack is empty");
+        }
+        return *top->slot(topCount - 1);
+    }
+    const T& peek() const { return const_cast<SegmentedStack*>(this)->peek(); }
+
+    bool isEmpty() const { return count == 0; }
+    size_t size() const { return count; }
+    static constexpr size_t chunkCapacity() { return ChunkCapacity; }
+
+    // destroys the elements and frees their chunks; the spare chunk is kept
+    void clear() noexcept {
+        while (nullptr != top) {
+            for (size_t i = topCount; i > 0; --i) top->slot(i - 1)->~T();
+            Chunk* emptied = top;
+            top = emptied->previous;
+            topCount = ChunkCapacity;
+            giveBack(emptied);
+        }
+        topCount = 0;
+        count = 0;
+    }
+};
@@ -0,0 +1,210 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Stack that keeps its first N elements inside the object and moves them to the heap only when the
+// (N + 1)th is pushed, so a stack that stays small never allocates. Past N it grows like Stack<T>:
+// capacity doubles and elements are relocated with memcpy when T is trivially copyable, otherwise by
+// move construction (copy when the move constructor can throw).
+//
+// Moving a heap stack steals its buffer; moving an inline one moves its elements, still without
+// allocating.
+template <typename T, size_t N = 16>
+class SmallStack {
+    static_assert(N > 0, "SmallStack needs room for at least one inline element");
+
+private:
+    alignas(T) unsigned char buffer[N * sizeof(T)];
+    T* items = inlineItems();
+    size_t capacity = N;
+    size_t count = 0;
+
+    T* inlineItems() { return reinterpret_cast<T*>(buffer); }
+
+    static T* allocate(size_t n) { return std::allocator<T>().allocate(n); }
+    static void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    // destroys every element and goes back to the inline buffer
+    void release() noexcept {
+        clear();
+        if (!isInline()) deallocate(items, capacity);
+        items = inlineItems();
+        capacity = N;
+    }
+
+    // moves (or, when moving can throw, copies) n elements into the uninitialized buffer at to
+    static void relocate(T* from, size_t n, T* to) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n > 0) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+        } else {
+            size_t done = 0;
+            try {
+                for (; done < n; ++done) ::new (static_cast<void*>(to + done)) T(std::move_if_noexcept(from[done]));
+            } catch (...) {
+                for (size_t i = 0; i < done; ++i) to[i].~T();
+                throw;
+            }
+            for (size_t i = 0; i < n; ++i) from[i].~T();
+        }
+    }
+
+    // moves the elements into a buffer of max(newCapacity, N) >= count, inline when it fits
+    void reallocate(size_t newCapacity) {
+        newCapacity = std::max(newCapacity, N);
+        if (newCapacity == capacity) return;
+        T* newItems = newCapacity == N ? inlineItems() : allocate(newCapacity);
+        try {
+            relocate(items, count, newItems);
+        } catch (...) {
+            if (newItems != inlineItems()) deallocate(newItems, newCapacity);
+            throw;
+        }
+        if (!isInline()) deallocate(items, capacity);
+        items = newItems;
+        capacity = newCapacity;
+    }
+
+    // builds the new element in the new buffer before moving the old ones, so args may refer to an element
+    template <typename... Args>
+    T& emplaceWithGrowth(Args&&... args) {
+        const size_t newCapacity = capacity * 2;
+        T* newItems = allocate(newCapacity);
+        try {
+            ::new (static_cast<void*>(newItems + count)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(newItems, newCapacity);
+            throw;
+        }
+        try {
+            relocate(items, count, newItems);
+        } catch (...) {
+            newItems[count].~T();
+            deallocate(newItems, newCapacity);
+            throw;
+        }
+        if (!isInline()) deallocate(items, capacity);
+        items = newItems;
+        capacity = newCapacity;
+        return items[count++];
+    }
+
+    // takes over the elements of toMove, which is left empty and inline; this stack must be empty and inline
+    void moveFrom(SmallStack& toMove) {
+        if (toMove.isInline()) {
+            relocate(toMove.items, toMove.count, items);
+            count = toMove.count;
+        } else {
+            items = toMove.items;
+            capacity = toMove.capacity;
+            count = toMove.count;
+            toMove.items = toMove.inlineItems();
+            toMove.capacity = N;
+        }
+        toMove.count = 0;
+    }
+
+    void copyFrom(const SmallStack& toCopy) {
+        reserve(toCopy.count);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (toCopy.count > 0)
+                std::memcpy(static_cast<void*>(items), static_cast<const void*>(toCopy.items),
+                            toCopy.count * sizeof(T));
+            count = toCopy.count;
+        } else {
+            for (; count < toCopy.count; ++count) ::new (static_cast<void*>(items + count)) T(toCopy.items[count]);
+        }
+    }
+
+public:
+    SmallStack() = default;
+
+    // can throw exception: whatever T's copy constructor throws or std::bad_alloc
+    SmallStack(const SmallStack& toCopy) {
+        try {
+            copyFrom(toCopy);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    SmallStack(SmallStack&& toMove) noexcept(std::is_nothrow_move_constructible_v<T>) { moveFrom(toMove); }
+
+    // Strong guarantee only for trivially copyable T.
+    SmallStack& operator=(const SmallStack& toCopy) {
+        if (this != &toCopy) {
+            clear();
+            copyFrom(toCopy);
+        }
+        return *this;
+    }
+
+    SmallStack& operator=(SmallStack&& toMove) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &toMove) {
+            release();
+            moveFrom(toMove);
+        }
+        return *this;
+    }
+
+    ~SmallStack() { release(); }
+
+    // can throw exception: whatever T's constructor throws or std::bad_alloc; the stack is then unchanged
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if (count == capacity) return emplaceWithGrowth(std::forward<Args>(args)...);
+        ::new (static_cast<void*>(items + count)) T(std::forward<Args>(args)...);
+        return items[count++];
+    }
+
+    void push(const T& item) { emplace(item); }
+    void push(T&& item) { emplace(std::move(item)); }
+
+    // can throw exception: std::underflow_error when the stack is empty
+    T pop() {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack is empty");
+        }
+        T item(std::move(items[count - 1]));
+        items[--count].~T();
+        return item;
+    }
+
+    // can throw exception: std::underflow_error when the stack is empty
+    T& peek() {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack is empty");
+        }
+        return items[count - 1];
+    }
+    const T& peek() const { return const_cast<SmallStack*>(this)->peek(); }
+
+    bool isEmpty() const { return count == 0; }
+    size_t size() const { return count; }
+    size_t getCapacity() const { return capacity; }
+    // true while the elements live inside the object
+    bool isInline() const { return items == reinterpret_cast<const T*>(buffer); }
+
+    // can throw exception: whatever T's constructor throws or std::bad_alloc; the stack is then unchanged
+    void reserve(size_t newCapacity) {
+        if (newCapacity > capacity) reallocate(newCapacity);
+    }
+    // releases unused heap capacity, moving the elements back inline when they fit
+    void shrinkToFit() {
+        if (!isInline() && count < capacity) reallocate(count);
+    }
+
+    // destroys the elements, keeps the buffer
+    void clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = count; i > 0; --i) items[i - 1].~T();
+        }
+        count = 0;
+    }
+};
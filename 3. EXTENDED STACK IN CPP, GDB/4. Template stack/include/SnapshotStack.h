@@ -0,0 +1,159 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Copy-on-write stack: copying (a snapshot) is O(1) whatever the size. The elements live in chunks of
+// ChunkCapacity that copies share by reference count; every chunk below the top one is full and never
+// changes again. Pushing or popping on a stack whose top chunk is shared first copies that one chunk,
+// so a mutation after a snapshot costs at most ChunkCapacity element copies.
+//
+// Whether a chunk is shared is read from shared_ptr::use_count(), so a stack and its snapshots must not be
+// used from several threads at the same time.
+template <typename T, size_t ChunkCapacity = 32>
+class SnapshotStack {
+    static_assert(std::is_copy_constructible_v<T>, "SnapshotStack copies elements out of shared chunks");
+    static_assert(ChunkCapacity > 0, "SnapshotStack needs room for at least one element per chunk");
+
+private:
+    struct Chunk {
+        std::shared_ptr<Chunk> previous;
+        // elements built in storage; a stack sharing the chunk may see fewer of them
+        size_t constructed = 0;
+        alignas(T) unsigned char storage[ChunkCapacity * sizeof(T)];
+
+        explicit Chunk(std::shared_ptr<Chunk> previous) : previous(std::move(previous)) {}
+        Chunk(const Chunk&) = delete;
+        Chunk& operator=(const Chunk&) = delete;
+
+        ~Chunk() {
+            truncate(0);
+            // unlinks the chunks below one by one, so releasing a long stack does not recurse
+            std::shared_ptr<Chunk> below = std::move(previous);
+            while (below && below.use_count() == 1) below = std::move(below->previous);
+        }
+
+        void* raw(size_t i) { return storage + i * sizeof(T); }
+        T* slot(size_t i) { return std::launder(reinterpret_cast<T*>(raw(i))); }
+        void truncate(size_t n) noexcept {
+            for (; constructed > n; --constructed) slot(constructed - 1)->~T();
+        }
+    };
+
+    std::shared_ptr<Chunk> top;
+    // elements of the top chunk this stack sees
+    size_t topCount = 0;
+    size_t count = 0;
+
+    bool ownsTop() const { return top.use_count() == 1; }
+
+    // leaves top a chunk only this stack uses, holding exactly topCount elements; the stack is unchanged
+    // when copying an element throws
+    void makeTopWritable() {
+        if (ownsTop()) {
+            top->truncate(topCount);
+            return;
+        }
+        auto copy = std::make_shared<Chunk>(top->previous);
+        for (; copy->constructed < topCount; ++copy->constructed) {
+            ::new (copy->raw(copy->constructed)) T(*top->slot(copy->constructed));
+        }
+        top = std::move(copy);
+    }
+
+    // forgets the top element of this stack's view, moving down a chunk when the top one runs out
+    void dropTop() noexcept {
+        --count;
+        if (--topCount == 0) {
+            top = std::shared_ptr<Chunk>(top->previous);
+            topCount = nullptr == top ? 0 : ChunkCapacity;
+        }
+    }
+
+public:
+    SnapshotStack() = default;
+    // O(1): shares every chunk
+    SnapshotStack(const SnapshotStack&) = default;
+    SnapshotStack(SnapshotStack&& toMove) noexcept
+        : top(std::move(toMove.top)), topCount(toMove.topCount), count(toMove.count) {
+        toMove.topCount = 0;
+        toMove.count = 0;
+    }
+    SnapshotStack& operator=(const SnapshotStack&) = default;
+    SnapshotStack& operator=(SnapshotStack&& toMove) noexcept {
+        if (this != &toMove) {
+            top = std::move(toMove.top);
+            topCount = toMove.topCount;
+            count = toMove.count;
+            toMove.topCount = 0;
+            toMove.count = 0;
+        }
+        return *this;
+    }
+    ~SnapshotStack() = default;
+
+    // the same as copying; reads better where the copy is kept for backtracking
+    SnapshotStack snapshot() const { return *this; }
+
+    // The returned reference is only valid until the stack is next copied or changed.
+    // can throw exception: whatever T's constructor throws or std::bad_alloc; the stack is then unchanged
+    template <typename... Args>
+    const T& emplace(Args&&... args) {
+        if (nullptr == top || topCount == ChunkCapacity) {
+            auto chunk = std::make_shared<Chunk>(top);
+            ::new (chunk->raw(0)) T(std::forward<Args>(args)...);
+            chunk->constructed = 1;
+            top = std::move(chunk);
+            topCount = 1;
+        } else {
+            makeTopWritable();
+            ::new (top->raw(topCount)) T(std::forward<Args>(args)...);
+            top->constructed = ++topCount;
+        }
+        ++count;
+        return *top->slot(topCount - 1);
+    }
+
+    void push(const T& item) { emplace(item); }
+    void push(T&& item) { emplace(std::move(item)); }
+
+    // moves the element out when no snapshot shares it, copies it otherwise
+    // can throw exception: std::underflow_error when the stack is empty
+    T pop() {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack is empty");
+        }
+        T* slot = top->slot(topCount - 1);
+        if (ownsTop()) {
+            top->truncate(topCount);
+            T item(std::move(*slot));
+            top->truncate(topCount - 1);
+            dropTop();
+            return item;
+        }
+        T item(*slot);
+        dropTop();
+        return item;
+    }
+
+    // can throw exception: std::underflow_error when the stack is empty
+    const T& peek() const {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack is empty");
+        }
+        return *top->slot(topCount - 1);
+    }
+
+    bool isEmpty() const { return count == 0; }
+    size_t size() const { return count; }
+    static constexpr size_t chunkCapacity() { return ChunkCapacity; }
+
+    void clear() noexcept {
+        top.reset();
+        topCount = 0;
+        count = 0;
+    }
+};
@@ -0,0 +1,282 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Stack of any element type, including move-only ones. Storage comes from Allocator and is
+// allocated on the first push, so an empty stack owns no memory.
+//
+// Growth doubles the capacity and relocates the elements: with memcpy when T is trivially copyable,
+// otherwise by move construction (copy when the move constructor can throw, so a failed growth leaves
+// the stack unchanged).
+template <typename T, typename Allocator = std::allocator<T>>
+class Stack {
+private:
+    using Traits = std::allocator_traits<Allocator>;
+
+    Allocator allocator;
+    T* items = nullptr;
+    size_t capacity = 0;
+    size_t count = 0;
+
+    static constexpr size_t MIN_CAPACITY = 8;
+
+    // destroys every element and returns the buffer to the allocator
+    void release() noexcept {
+        clear();
+        if (nullptr != items) Traits::deallocate(allocator, items, capacity);
+        items = nullptr;
+        capacity = 0;
+    }
+
+    // moves (or, when moving can throw, copies) n elements into the uninitialized buffer at to
+    static void relocate(Allocator& allocator, T* from, size_t n, T* to) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n > 0) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+        } else {
+            size_t done = 0;
+            try {
+                for (; done < n; ++done) Traits::construct(allocator, to + done, std::move_if_noexcept(from[done]));
+            } catch (...) {
+                for (size_t i = 0; i < done; ++i) Traits::destroy(allocator, to + i);
+                throw;
+            }
+            for (size_t i = 0; i < n; ++i) Traits::destroy(allocator, from + i);
+        }
+    }
+
+    // moves the elements into a buffer of exactly newCapacity >= count
+    void reallocate(size_t newCapacity) {
+        T* newItems = newCapacity == 0 ? nullptr : Traits::allocate(allocator, newCapacity);
+        try {
+            relocate(allocator, items, count, newItems);
+        } catch (...) {
+            Traits::deallocate(allocator, newItems, newCapacity);
+            throw;
+        }
+        if (nullptr != items) Traits::deallocate(allocator, items, capacity);
+        items = newItems;
+        capacity = newCapacity;
+    }
+
+    // can throw exception: std::underflow_error when there are fewer than n elements
+    void requireItems(size_t n) const {
+        if (n > count) {
+            throw std::underflow_error("Stack has fewer items than requested");
+        }
+    }
+
+    // builds the new element in the new buffer before moving the old ones, so args may refer to an element
+    template <typename... Args>
+    T& emplaceWithGrowth(Args&&... args) {
+        const size_t newCapacity = capacity == 0 ? MIN_CAPACITY : capacity * 2;
+        T* newItems = Traits::allocate(allocator, newCapacity);
+        try {
+            Traits::construct(allocator, newItems + count, std::forward<Args>(args)...);
+        } catch (...) {
+            Traits::deallocate(allocator, newItems, newCapacity);
+            throw;
+        }
+        try {
+            relocate(allocator, items, count, newItems);
+        } catch (...) {
+            Traits::destroy(allocator, newItems + count);
+            Traits::deallocate(allocator, newItems, newCapacity);
+            throw;
+        }
+        if (nullptr != items) Traits::deallocate(allocator, items, capacity);
+        items = newItems;
+        capacity = newCapacity;
+        return items[count++];
+    }
+
+    void copyFrom(const Stack& toCopy) {
+        items = Traits::allocate(allocator, toCopy.count);
+        capacity = toCopy.count;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(static_cast<void*>(items), static_cast<const void*>(toCopy.items), toCopy.count * sizeof(T));
+            count = toCopy.count;
+        } else {
+            for (; count < toCopy.count; ++count) Traits::construct(allocator, items + count, toCopy.items[count]);
+        }
+    }
+
+public:
+    Stack() = default;
+    explicit Stack(const Allocator& allocator) : allocator(allocator) {}
+
+    // can throw exception: whatever T's copy constructor or the allocator throws
+    Stack(const Stack& toCopy) : allocator(Traits::select_on_container_copy_construction(toCopy.allocator)) {
+        if (toCopy.count == 0) return;
+        try {
+            copyFrom(toCopy);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    Stack(Stack&& toMove) noexcept
+        : allocator(std::move(toMove.allocator)), items(toMove.items), capacity(toMove.capacity),
+          count(toMove.count) {
+        toMove.items = nullptr;
+        toMove.capacity = 0;
+        toMove.count = 0;
+    }
+
+    // Reuses the current buffer when it is large enough, so assigning never frees or allocates
+    // unnecessarily. Strong guarantee only for trivially copyable T.
+    Stack& operator=(const Stack& toCopy) {
+        if (this == &toCopy) return *this;
+        if constexpr (Traits::propagate_on_container_copy_assignment::value) {
+            if (allocator != toCopy.allocator) release();
+            allocator = toCopy.allocator;
+        }
+        if (capacity < toCopy.count) {
+            T* newItems = Traits::allocate(allocator, toCopy.count);
+            release();
+            items = newItems;
+            capacity = toCopy.count;
+        }
+        clear();
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (toCopy.count > 0)
+                std::memcpy(static_cast<void*>(items), static_cast<const void*>(toCopy.items),
+                            toCopy.count * sizeof(T));
+            count = toCopy.count;
+        } else {
+            for (; count < toCopy.count; ++count) Traits::construct(allocator, items + count, toCopy.items[count]);
+        }
+        return *this;
+    }
+
+    Stack& operator=(Stack&& toMove) noexcept(Traits::propagate_on_container_move_assignment::value ||
+                                              Traits::is_always_equal::value) {
+        if (this == &toMove) return *this;
+        if (Traits::propagate_on_container_move_assignment::value || allocator == toMove.allocator) {
+            release();
+            if constexpr (Traits::propagate_on_container_move_assignment::value) {
+                allocator = std::move(toMove.allocator);
+            }
+            items = toMove.items;
+            capacity = toMove.capacity;
+            count = toMove.count;
+            toMove.items = nullptr;
+            toMove.capacity = 0;
+            toMove.count = 0;
+        } else {
+            // allocators differ and stay put: move element by element into our own storage
+            clear();
+            for (size_t i = 0; i < toMove.count; ++i) push(std::move(toMove.items[i]));
+            toMove.clear();
+        }
+        return *this;
+    }
+
+    ~Stack() { release(); }
+
+    // can throw exception: whatever T's constructor or the allocator throws; the stack is then unchanged
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if (count == capacity) return emplaceWithGrowth(std::forward<Args>(args)...);
+        Traits::construct(allocator, items + count, std::forward<Args>(args)...);
+        return items[count++];
+    }
+
+    void push(const T& item) { emplace(item); }
+    void push(T&& item) { emplace(std::move(item)); }
+
+    // can throw exception: std::underflow_error when the stack is empty
+    T pop() {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack is empty");
+        }
+        T item(std::move(items[count - 1]));
+        Traits::destroy(allocator, items + --count);
+        return item;
+    }
+
+    bool isEmpty() const { return count == 0; }
+    size_t size() const { return count; }
+    size_t getCapacity() const { return capacity; }
+
+    // can throw exception: std::underflow_error when the stack is empty
+    T& peek() {
+        requireItems(1);
+        return items[count - 1];
+    }
+    const T& peek() const {
+        requireItems(1);
+        return items[count - 1];
+    }
+
+    // can throw exception: whatever the allocator or relocating T throws; the stack is then unchanged
+    void reserve(size_t newCapacity) {
+        if (newCapacity > capacity) reallocate(newCapacity);
+    }
+    // releases all unused capacity; an empty stack frees its buffer
+    void shrinkToFit() {
+        if (count < capacity) reallocate(count);
+    }
+
+    // Bulk transfers check the capacity once. Contiguous ranges of trivially copyable T move with one
+    // memcpy. out receives the top n elements bottom to top, the order pushRange takes them in, so
+    // pushRange(out, out + n) after popN(n, out) restores the stack.
+
+    // can throw exception: whatever T's constructor or the allocator throws; elements constructed
+    // before the failure stay on the stack
+    template <typename InputIt>
+    void pushRange(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            const size_t n = std::distance(first, last);
+            if (count + n > capacity) reallocate(std::max(count + n, 2 * capacity));
+            if constexpr (std::is_trivially_copyable_v<T> && std::is_pointer_v<InputIt> &&
+                          std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, T>) {
+                if (n > 0) {
+                    std::memcpy(static_cast<void*>(items + count), static_cast<const void*>(first), n * sizeof(T));
+                }
+                count += n;
+            } else {
+                for (; first != last; ++first) {
+                    Traits::construct(allocator, items + count, *first);
+                    ++count;
+                }
+            }
+        } else {
+            for (; first != last; ++first) emplace(*first);
+        }
+    }
+
+    // moves the top n elements out; can throw exception: std::underflow_error when there are fewer than
+    // n elements, nothing is popped then
+    template <typename OutputIt>
+    OutputIt popN(size_t n, OutputIt out) {
+        requireItems(n);
+        out = std::move(items + count - n, items + count, out);
+        for (size_t i = 0; i < n; ++i) Traits::destroy(allocator, items + --count);
+        return out;
+    }
+
+    // can throw exception: std::underflow_error when there are fewer than n elements
+    template <typename OutputIt>
+    OutputIt peekN(size_t n, OutputIt out) const {
+        requireItems(n);
+        return std::copy(items + count - n, items + count, out);
+    }
+
+    // destroys the elements, keeps the buffer
+    void clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = count; i > 0; --i) Traits::destroy(allocator, items + i - 1);
+        }
+        count = 0;
+    }
+
+    Allocator getAllocator() const { return allocator; }
+};
@@ -0,0 +1,48 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include "../include/Stack.h"
+
+using namespace std;
+
+void runFunction1(Stack<string> stack) {
+    cout << "Inside runFunction1" << endl;
+    stack.push("temporary");
+    stack.pop();
+}
+
+void runFunction2(Stack<string>& stack) {
+    cout << "Inside runFunction2" << endl;
+    stack.push("temporary");
+    stack.pop();
+}
+
+int main() {
+    Stack<string> s1;
+    s1.push("one");
+    s1.push("two");
+    s1.emplace(3, '!');
+
+    Stack<string> s2(s1);
+
+    Stack<string> s3 = s1;
+
+    Stack<string> s4;
+    s4.push("ten");
+    s4 = s1;
+
+    runFunction1(s1);
+    runFunction2(s1);
+
+    // move-only elements
+    Stack<unique_ptr<int>> owners;
+    owners.push(make_unique<int>(42));
+    unique_ptr<int> owner = owners.pop();
+    cout << "Popped " << *owner << ", then:";
+    while (!s4.isEmpty()) {
+        cout << " " << s4.pop();
+    }
+    cout << endl;
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "../include/SegmentedStack.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// four elements per chunk, so small tests cross many chunk boundaries
+template <typename T>
+using SmallChunks = SegmentedStack<T, 4>;
+
+TEST(SegmentedStack, LifoOrderAcrossChunks) {
+    SmallChunks<int> stack;
+    EXPECT_TRUE(stack.isEmpty());
+    for (int i = 0; i < 1000; ++i) stack.push(i);
+    EXPECT_EQ(1000u, stack.size());
+    EXPECT_EQ(999, stack.peek());
+    for (int i = 999; i >= 0; --i) EXPECT_EQ(i, stack.pop());
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_THROW(stack.pop(), std::underflow_error);
+    EXPECT_THROW(stack.peek(), std::underflow_error);
+}
+
+struct Huge {
+    char bytes[100000];
+};
+
+TEST(SegmentedStack, DefaultChunksHoldAbout64KiB) {
+    EXPECT_EQ(16382u, SegmentedStack<int>::chunkCapacity());
+    EXPECT_EQ(1u, SegmentedStack<Huge>::chunkCapacity());
+}
+
+TEST(SegmentedStack, ReferencesStayValidWhileGrowing) {
+    SmallChunks<std::string> stack;
+    std::vector<std::string*> addresses;
+    for (int i = 0; i < 100; ++i) addresses.push_back(&stack.emplace(std::to_string(i)));
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(std::to_string(i), *addresses[i]);
+    EXPECT_EQ(addresses.back(), &stack.peek());
+}
+
+TEST(SegmentedStack, MoveOnlyElements) {
+    SmallChunks<std::unique_ptr<int>> stack;
+    for (int i = 0; i < 10; ++i) stack.push(std::make_unique<int>(i));
+    SmallChunks<std::unique_ptr<int>> moved(std::move(stack));
+    EXPECT_TRUE(stack.isEmpty());
+    for (int i = 9; i >= 0; --i) EXPECT_EQ(i, *moved.pop());
+}
+
+TEST(SegmentedStack, CopyAndAssign) {
+    SmallChunks<std::string> stack;
+    for (int i = 0; i < 11; ++i) stack.push(std::to_string(i));
+    SmallChunks<std::string> copy(stack), assigned;
+    assigned.push("overwritten");
+    assigned = stack;
+    stack.pop();
+    EXPECT_EQ(11u, copy.size());
+    for (int i = 10; i >= 0; --i) {
+        EXPECT_EQ(std::to_string(i), copy.pop());
+        EXPECT_EQ(std::to_string(i), assigned.pop());
+    }
+    EXPECT_EQ(10u, stack.size());
+}
+
+// counts live instances, and throws from the constructor when armed
+struct Counted {
+    static int live;
+    static bool failNext;
+    explicit Counted(int) {
+        if (failNext) throw std::runtime_error("construction failed");
+        ++live;
+    }
+    Counted(const Counted&) { ++live; }
+    ~Counted() { --live; }
+};
+int Counted::live = 0;
+bool Counted::failNext = false;
+
+TEST(SegmentedStack, DestroysEveryElementAndSurvivesThrowingConstructors) {
+    {
+        SmallChunks<Counted> stack;
+        for (int i = 0; i < 8; ++i) stack.emplace(i);
+        Counted::failNext = true;
+        EXPECT_THROW(stack.emplace(8), std::runtime_error);
+        Counted::failNext = false;
+        EXPECT_EQ(8u, stack.size());
+        stack.emplace(8);
+        stack.pop();
+        stack.clear();
+        EXPECT_EQ(0, Counted::live);
+        for (int i = 0; i < 6; ++i) stack.emplace(i);
+    }
+    EXPECT_EQ(0, Counted::live);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "../include/SmallStack.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+TEST(SmallStack, StaysInlineUpToN) {
+    SmallStack<int, 4> stack;
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_TRUE(stack.isInline());
+    EXPECT_EQ(4u, stack.getCapacity());
+    for (int i = 0; i < 4; ++i) stack.push(i);
+    EXPECT_TRUE(stack.isInline());
+    stack.push(4);
+    EXPECT_FALSE(stack.isInline());
+    EXPECT_EQ(8u, stack.getCapacity());
+    for (int i = 4; i >= 0; --i) EXPECT_EQ(i, stack.pop());
+    EXPECT_THROW(stack.pop(), std::underflow_error);
+    EXPECT_THROW(stack.peek(), std::underflow_error);
+}
+
+TEST(SmallStack, MovesInlineAndHeapStacks) {
+    SmallStack<std::unique_ptr<int>, 4> small, large;
+    for (int i = 0; i < 3; ++i) small.push(std::make_unique<int>(i));
+    for (int i = 0; i < 20; ++i) large.push(std::make_unique<int>(i));
+    const int* largeBottom = large.peek().get();
+
+    SmallStack<std::unique_ptr<int>, 4> fromSmall(std::move(small)), fromLarge(std::move(large));
+    EXPECT_TRUE(small.isEmpty());
+    EXPECT_TRUE(large.isEmpty());
+    EXPECT_TRUE(large.isInline());
+    EXPECT_TRUE(fromSmall.isInline());
+    EXPECT_EQ(largeBottom, fromLarge.peek().get());
+
+    fromSmall = std::move(fromLarge);
+    EXPECT_EQ(20u, fromSmall.size());
+    for (int i = 19; i >= 0; --i) EXPECT_EQ(i, *fromSmall.pop());
+}
+
+TEST(SmallStack, CopyAndAssign) {
+    SmallStack<std::string, 2> inlineStack, heapStack;
+    inlineStack.push("a");
+    for (int i = 0; i < 10; ++i) heapStack.push(std::to_string(i));
+
+    SmallStack<std::string, 2> copy(heapStack);
+    EXPECT_EQ(10u, copy.getCapacity());
+    copy = inlineStack;
+    EXPECT_EQ("a", copy.pop());
+    copy = heapStack;
+    for (int i = 9; i >= 0; --i) EXPECT_EQ(std::to_string(i), copy.pop());
+    EXPECT_EQ(10u, heapStack.size());
+}
+
+TEST(SmallStack, PushOfOwnElementDuringGrowth) {
+    SmallStack<std::string, 2> stack;
+    stack.push("first");
+    stack.push("second");
+    stack.push(stack.peek());
+    EXPECT_EQ("second", stack.pop());
+}
+
+TEST(SmallStack, ShrinkToFitMovesBackInline) {
+    SmallStack<std::string, 4> stack;
+    stack.reserve(100);
+    EXPECT_FALSE(stack.isInline());
+    for (int i = 0; i < 3; ++i) stack.push(std::to_string(i));
+    stack.shrinkToFit();
+    EXPECT_TRUE(stack.isInline());
+    EXPECT_EQ(4u, stack.getCapacity());
+    EXPECT_EQ("2", stack.peek());
+}
+
+// counts live instances, and throws from the copy constructor when armed
+struct Fragile {
+    static int live;
+    static int copiesUntilThrow;
+
+    Fragile() { ++live; }
+    Fragile(const Fragile&) {
+        if (copiesUntilThrow > 0 && --copiesUntilThrow == 0) throw std::runtime_error("copy failed");
+        ++live;
+    }
+    ~Fragile() { --live; }
+};
+int Fragile::live = 0;
+int Fragile::copiesUntilThrow = 0;
+
+TEST(SmallStack, FailedSpillLeavesTheStackUnchanged) {
+    {
+        // Fragile has no move constructor, so spilling to the heap copies
+        SmallStack<Fragile, 4> stack;
+        for (int i = 0; i < 4; ++i) stack.emplace();
+        Fragile::copiesUntilThrow = 3;
+        EXPECT_THROW(stack.emplace(), std::runtime_error);
+        Fragile::copiesUntilThrow = 0;
+        EXPECT_TRUE(stack.isInline());
+        EXPECT_EQ(4, Fragile::live);
+        stack.emplace();
+        SmallStack<Fragile, 4> copy(stack);
+        EXPECT_EQ(10, Fragile::live);
+    }
+    EXPECT_EQ(0, Fragile::live);
+}
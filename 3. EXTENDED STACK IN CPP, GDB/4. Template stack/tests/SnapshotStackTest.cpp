@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "../include/SnapshotStack.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// four elements per chunk, so small tests cross chunk boundaries
+template <typename T>
+using SmallChunks = SnapshotStack<T, 4>;
+
+TEST(SnapshotStack, LifoOrderAcrossChunks) {
+    SmallChunks<int> stack;
+    EXPECT_TRUE(stack.isEmpty());
+    for (int i = 0; i < 100; ++i) stack.push(i);
+    EXPECT_EQ(100u, stack.size());
+    EXPECT_EQ(99, stack.peek());
+    for (int i = 99; i >= 0; --i) EXPECT_EQ(i, stack.pop());
+    EXPECT_THROW(stack.pop(), std::underflow_error);
+    EXPECT_THROW(stack.peek(), std::underflow_error);
+}
+
+TEST(SnapshotStack, SnapshotsAreIndependent) {
+    SmallChunks<std::string> stack;
+    for (int i = 0; i < 10; ++i) stack.push(std::to_string(i));
+    SmallChunks<std::string> before = stack.snapshot();
+
+    // pop into the shared chunks, then push over what the snapshot still sees
+    for (int i = 0; i < 7; ++i) stack.pop();
+    for (int i = 0; i < 5; ++i) stack.push("new" + std::to_string(i));
+    SmallChunks<std::string> after = stack;
+    stack.push("latest");
+
+    ASSERT_EQ(10u, before.size());
+    for (int i = 9; i >= 0; --i) EXPECT_EQ(std::to_string(i), before.pop());
+    ASSERT_EQ(8u, after.size());
+    for (int i = 4; i >= 0; --i) EXPECT_EQ("new" + std::to_string(i), after.pop());
+    for (int i = 2; i >= 0; --i) EXPECT_EQ(std::to_string(i), after.pop());
+    EXPECT_EQ("latest", stack.peek());
+    EXPECT_EQ(9u, stack.size());
+}
+
+// every branch of a depth-first search keeps its own snapshot of the path
+static void enumerate(SmallChunks<int> path, int depth, std::vector<std::vector<int>>& found) {
+    if (depth == 0) {
+        std::vector<int> items;
+        while (!path.isEmpty()) items.insert(items.begin(), path.pop());
+        found.push_back(items);
+        return;
+    }
+    for (int choice = 0; choice < 2; ++choice) {
+        SmallChunks<int> branch = path;
+        branch.push(choice);
+        enumerate(branch, depth - 1, found);
+    }
+}
+
+TEST(SnapshotStack, BacktrackingOverSharedPaths) {
+    SmallChunks<int> root;
+    for (int i = 0; i < 6; ++i) root.push(7);
+    std::vector<std::vector<int>> found;
+    enumerate(root, 3, found);
+    ASSERT_EQ(8u, found.size());
+    EXPECT_EQ((std::vector<int>{7, 7, 7, 7, 7, 7, 1, 0, 1}), found[5]);
+    EXPECT_EQ(6u, root.size());
+}
+
+TEST(SnapshotStack, MovesLeaveTheSourceEmpty) {
+    SmallChunks<std::string> stack;
+    stack.push("a");
+    SmallChunks<std::string> moved(std::move(stack));
+    EXPECT_TRUE(stack.isEmpty());
+    stack = std::move(moved);
+    EXPECT_TRUE(moved.isEmpty());
+    EXPECT_EQ("a", stack.pop());
+}
+
+TEST(SnapshotStack, ReleasesLongStacksWithoutRecursing) {
+    auto* stack = new SnapshotStack<int, 1>;
+    for (int i = 0; i < 1000000; ++i) stack->push(i);
+    SnapshotStack<int, 1> snapshot = *stack;
+    delete stack;
+    EXPECT_EQ(999999, snapshot.pop());
+    snapshot.clear();
+    EXPECT_TRUE(snapshot.isEmpty());
+}
+
+// counts live instances, and throws from the copy constructor when armed
+struct Copyable {
+    static int live;
+    static bool failCopies;
+    int value;
+
+    explicit Copyable(int value) : value(value) { ++live; }
+    Copyable(const Copyable& other) : value(other.value) {
+        if (failCopies) throw std::runtime_error("copy failed");
+        ++live;
+    }
+    ~Copyable() { --live; }
+};
+int Copyable::live = 0;
+bool Copyable::failCopies = false;
+
+TEST(SnapshotStack, FailedCopyOfTheTopChunkLeavesTheStackUnchanged) {
+    {
+        SmallChunks<Copyable> stack;
+        for (int i = 0; i < 6; ++i) stack.emplace(i);
+        SmallChunks<Copyable> snapshot = stack;
+        Copyable::failCopies = true;
+        EXPECT_THROW(stack.emplace(6), std::runtime_error);
+        Copyable::failCopies = false;
+        EXPECT_EQ(6u, stack.size());
+        EXPECT_EQ(6, Copyable::live);
+        stack.emplace(6);
+        EXPECT_EQ(6, stack.peek().value);
+        EXPECT_EQ(5, snapshot.peek().value);
+    }
+    EXPECT_EQ(0, Copyable::live);
+}
@@ -0,0 +1,278 @@
+#include <gtest/gtest.h>
+#include "../include/Stack.h"
+#include <climits>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(InitializeStack, CreatesEmptyStack) {
+    Stack<int> stack;
+    EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(BasicPushAndPop, SinglePushThenPop) {
+    Stack<int> stack;
+    stack.push(21);
+    EXPECT_FALSE(stack.isEmpty());
+    EXPECT_EQ(21, stack.pop());
+    EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(StressPushPop, PushAndFullPop) {
+    Stack<int> stack;
+    for (int i = 1; i <= 10000; ++i) {
+        stack.push(i);
+    }
+    for (int i = 10000; i >= 1; --i) {
+        EXPECT_EQ(i, stack.pop());
+    }
+    EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(PushIntLimits, HandlesMinAndMaxInt) {
+    Stack<int> stack;
+    stack.push(INT_MIN);
+    stack.push(INT_MAX);
+
+    EXPECT_EQ(INT_MAX, stack.pop());
+    EXPECT_EQ(INT_MIN, stack.pop());
+    EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(Exceptions, PopOnEmptyThrowsUnderflow) {
+    Stack<std::string> stack;
+    EXPECT_THROW(stack.pop(), std::underflow_error);
+}
+
+TEST(ElementTypes, StringsSurviveGrowth) {
+    Stack<std::string> stack;
+    for (int i = 0; i < 100; ++i) stack.push(std::string(40, static_cast<char>('a' + i % 26)));
+    for (int i = 99; i >= 0; --i) EXPECT_EQ(std::string(40, static_cast<char>('a' + i % 26)), stack.pop());
+}
+
+TEST(ElementTypes, MoveOnly) {
+    Stack<std::unique_ptr<int>> stack;
+    for (int i = 0; i < 20; ++i) stack.push(std::make_unique<int>(i));
+    auto moved = std::move(stack);
+    EXPECT_TRUE(stack.isEmpty());
+    for (int i = 19; i >= 0; --i) EXPECT_EQ(i, *moved.pop());
+}
+
+TEST(ElementTypes, EmplaceConstructsInPlace) {
+    Stack<std::pair<int, std::string>> stack;
+    auto& top = stack.emplace(3, "abc");
+    EXPECT_EQ(3, top.first);
+    top.second += "d";
+    EXPECT_EQ("abcd", stack.pop().second);
+}
+
+TEST(ElementTypes, PushOfOwnElementDuringGrowth) {
+    Stack<std::string> stack;
+    std::string* first = &stack.emplace("first");
+    for (int i = 1; i < 8; ++i) stack.push("x");
+    // the stack is full, so this push reallocates while reading *first
+    stack.push(*first);
+    EXPECT_EQ("first", stack.pop());
+}
+
+// counts live instances, and throws from the copy constructor when armed
+struct Tracked {
+    static int live;
+    static int copiesUntilThrow;
+    int value;
+
+    explicit Tracked(int value) : value(value) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) {
+        if (copiesUntilThrow > 0 && --copiesUntilThrow == 0) throw std::runtime_error("copy failed");
+        ++live;
+    }
+    ~Tracked() { --live; }
+};
+int Tracked::live = 0;
+int Tracked::copiesUntilThrow = 0;
+
+TEST(Lifetimes, EveryElementIsDestroyed) {
+    {
+        Stack<Tracked> stack;
+        for (int i = 0; i < 50; ++i) stack.emplace(i);
+        Stack<Tracked> copy(stack), assigned;
+        assigned = copy;
+        EXPECT_EQ(150, Tracked::live);
+        EXPECT_EQ(49, stack.pop().value);
+    }
+    EXPECT_EQ(0, Tracked::live);
+}
+
+TEST(Lifetimes, FailedGrowthLeavesTheStackUnchanged) {
+    // Tracked has no move constructor, so growth copies
+    Stack<Tracked> stack;
+    for (int i = 0; i < 8; ++i) stack.emplace(i);
+    Tracked::copiesUntilThrow = 5;
+    EXPECT_THROW(stack.emplace(8), std::runtime_error);
+    Tracked::copiesUntilThrow = 0;
+    EXPECT_EQ(8, Tracked::live);
+    for (int i = 7; i >= 0; --i) EXPECT_EQ(i, stack.pop().value);
+    EXPECT_EQ(0, Tracked::live);
+}
+
+TEST(Lifetimes, FailedPushRangeKeepsTheConstructedElements) {
+    {
+        Stack<Tracked> stack;
+        stack.reserve(8);
+        std::vector<Tracked> values;
+        for (int i = 0; i < 5; ++i) values.emplace_back(i);
+        Tracked::copiesUntilThrow = 3;
+        EXPECT_THROW(stack.pushRange(values.begin(), values.end()), std::runtime_error);
+        Tracked::copiesUntilThrow = 0;
+        EXPECT_EQ(2u, stack.size());
+        EXPECT_EQ(7, Tracked::live);
+        EXPECT_EQ(1, stack.pop().value);
+        stack.clear();
+        EXPECT_EQ(5, Tracked::live);
+    }
+    EXPECT_EQ(0, Tracked::live);
+}
+
+TEST(CopyConstructor, CopiesNonEmptyStack) {
+    Stack<std::string> stack;
+    stack.push("10");
+    stack.push("20");
+    Stack<std::string> copied(stack);
+    EXPECT_EQ("20", copied.pop());
+    EXPECT_EQ("10", copied.pop());
+    EXPECT_TRUE(copied.isEmpty());
+    // Original should not be modified by operations on copy
+    EXPECT_EQ("20", stack.pop());
+    EXPECT_EQ("10", stack.pop());
+}
+
+TEST(AssignmentOperator, SmallerToLargerAndBack) {
+    Stack<int> small, large;
+    small.push(1);
+    for (int i = 0; i < 100; ++i) large.push(i);
+    Stack<int> target = small;
+    target = large;
+    EXPECT_EQ(99, target.pop());
+    target = small;
+    EXPECT_EQ(1, target.pop());
+    EXPECT_TRUE(target.isEmpty());
+}
+
+TEST(AssignmentOperator, SelfAssignment) {
+    Stack<std::string> stack;
+    stack.push("2137");
+    auto& alias = stack;
+    stack = alias;
+    EXPECT_EQ("2137", stack.pop());
+    EXPECT_TRUE(stack.isEmpty());
+}
+
+// allocator with a per-instance id and a shared allocation counter
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+    int id = 0;
+    std::shared_ptr<int> allocations = std::make_shared<int>(0);
+
+    CountingAllocator() = default;
+    explicit CountingAllocator(int id) : id(id) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) : id(other.id), allocations(other.allocations) {}
+
+    T* allocate(size_t n) {
+        ++*allocations;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>& other) const { return id == other.id; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>& other) const { return id != other.id; }
+};
+
+TEST(Allocator, UsesTheGivenAllocator) {
+    CountingAllocator<int> allocator(1);
+    Stack<int, CountingAllocator<int>> stack(allocator);
+    EXPECT_EQ(0, *allocator.allocations);
+    for (int i = 0; i < 9; ++i) stack.push(i);
+    EXPECT_EQ(2, *allocator.allocations);
+    EXPECT_EQ(1, stack.getAllocator().id);
+}
+
+TEST(Allocator, MoveAssignBetweenUnequalAllocatorsMovesElements) {
+    Stack<std::string, CountingAllocator<std::string>> a{CountingAllocator<std::string>(1)},
+        b{CountingAllocator<std::string>(2)};
+    a.push("kept");
+    b = std::move(a);
+    EXPECT_EQ(2, b.getAllocator().id);
+    EXPECT_EQ("kept", b.pop());
+    EXPECT_TRUE(a.isEmpty());
+}
+
+TEST(BulkOperations, PushRangeThenPopNRoundTrips) {
+    Stack<int> stack;
+    stack.push(-1);
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    stack.pushRange(values.data(), values.data() + values.size());
+    EXPECT_EQ(1001u, stack.size());
+    EXPECT_EQ(999, stack.peek());
+
+    std::vector<int> out(1000);
+    EXPECT_EQ(out.end(), stack.popN(out.size(), out.begin()));
+    EXPECT_EQ(values, out);
+    EXPECT_EQ(-1, stack.pop());
+}
+
+TEST(BulkOperations, ConvertingAndInputRanges) {
+    Stack<long long> numbers;
+    const short values[] = {1, -2, 3};
+    numbers.pushRange(std::begin(values), std::end(values));
+    std::istringstream in("4 5");
+    numbers.pushRange(std::istream_iterator<long long>(in), std::istream_iterator<long long>());
+    long long top[2];
+    numbers.peekN(2, top);
+    EXPECT_EQ(4, top[0]);
+    EXPECT_EQ(5, top[1]);
+    EXPECT_EQ(5, numbers.pop());
+    EXPECT_EQ(4, numbers.pop());
+    EXPECT_EQ(3, numbers.pop());
+    EXPECT_EQ(-2, numbers.pop());
+}
+
+TEST(BulkOperations, PopNMovesElementsOut) {
+    Stack<std::unique_ptr<int>> stack;
+    for (int i = 0; i < 5; ++i) stack.push(std::make_unique<int>(i));
+    std::vector<std::unique_ptr<int>> out;
+    stack.popN(3, std::back_inserter(out));
+    ASSERT_EQ(3u, out.size());
+    EXPECT_EQ(2, *out[0]);
+    EXPECT_EQ(4, *out[2]);
+    EXPECT_EQ(1, *stack.peek());
+    EXPECT_THROW(stack.popN(3, std::back_inserter(out)), std::underflow_error);
+    EXPECT_EQ(2u, stack.size());
+}
+
+TEST(Capacity, ReserveAndShrinkToFit) {
+    Stack<std::string> stack;
+    EXPECT_EQ(0u, stack.getCapacity());
+    stack.reserve(100);
+    EXPECT_EQ(100u, stack.getCapacity());
+    for (int i = 0; i < 100; ++i) stack.push(std::to_string(i));
+    EXPECT_EQ(100u, stack.getCapacity());
+
+    std::vector<std::string> popped;
+    stack.popN(97, std::back_inserter(popped));
+    stack.shrinkToFit();
+    EXPECT_EQ(3u, stack.getCapacity());
+    EXPECT_EQ("2", stack.pop());
+    stack.clear();
+    stack.shrinkToFit();
+    EXPECT_EQ(0u, stack.getCapacity());
+    EXPECT_THROW(stack.peek(), std::underflow_error);
+}
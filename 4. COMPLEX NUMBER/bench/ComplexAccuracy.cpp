@@ -0,0 +1,248 @@
+// Accuracy of Complex, ComplexArray and ComplexMath against long double references.
+// For every operation it reports the largest error over random operands, in ulps of the reference's
+// magnitude: |computed - reference| / ulp(|reference|). Measuring against the magnitude, not each part,
+// keeps a part that cancels to nearly zero from reporting a meaningless huge relative error.
+//
+// Usage: complex_accuracy [samples]
+// Exits with status 1 when an operation exceeds its bound, so the run can serve as a regression check.
+#include "Complex.h"
+#include "ComplexArray.h"
+#include "ComplexMath.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using LongComplex = std::complex<long double>;
+using Backend = ComplexArray::SimdBackend;
+
+static LongComplex toLong(const Complex& c) { return {c.getReal(), c.getImag()}; }
+
+// spacing of doubles at |reference|, with the smallest subnormal as the floor
+static double ulpOf(long double reference) {
+    const double magnitude = std::fabs(static_cast<double>(reference));
+    if (!(magnitude < std::numeric_limits<double>::max())) return std::numeric_limits<double>::infinity();
+    return std::max(std::nextafter(magnitude, INFINITY) - magnitude, std::numeric_limits<double>::denorm_min());
+}
+
+static double ulpError(const Complex& computed, const LongComplex& reference) {
+    return static_cast<double>(std::abs(toLong(computed) - reference) / ulpOf(std::abs(reference)));
+}
+
+static double ulpError(double computed, long double reference) {
+    return static_cast<double>(std::fabs(computed - reference) / ulpOf(reference));
+}
+
+// operands for one operation: magnitudes spread log-uniformly over [2^-range, 2^range]
+static std::vector<Complex> makeOperands(size_t n, int range, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> exponent(-range, range), sign(-1.0, 1.0);
+    std::vector<Complex> values;
+    for (size_t i = 0; i < n; ++i) {
+        const double re = std::copysign(std::exp2(exponent(gen)), sign(gen));
+        const double im = std::copysign(std::exp2(exponent(gen)), sign(gen));
+        values.emplace_back(re, im);
+    }
+    return values;
+}
+
+// uniform over [-limit, limit] in both parts, for the transcendental functions
+static std::vector<Complex> makeBounded(size_t n, double limit, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-limit, limit);
+    std::vector<Complex> values;
+    for (size_t i = 0; i < n; ++i) values.emplace_back(dist(gen), dist(gen));
+    return values;
+}
+
+namespace {
+struct Result {
+    std::string name;
+    double maxUlps;
+    double bound;
+    Complex worstInput;
+};
+} // namespace
+
+static std::vector<Result> results;
+
+// errors[i] belongs to inputs[i]; records the largest
+static void record(const std::string& name, double bound, const std::vector<Complex>& inputs,
+                   const std::vector<double>& errors) {
+    Result result{name, 0.0, bound, Complex()};
+    for (size_t i = 0; i < errors.size(); ++i) {
+        if (errors[i] > result.maxUlps || std::isnan(errors[i])) {
+            result.maxUlps = errors[i];
+            result.worstInput = inputs[i];
+            if (std::isnan(errors[i])) break;
+        }
+    }
+    results.push_back(result);
+}
+
+static void measureScalar(size_t n) {
+    const auto a = makeOperands(n, 30, 1), b = makeOperands(n, 30, 2);
+    std::vector<double> add(n), multiply(n), divide(n), amplitude(n), phase(n);
+    for (size_t i = 0; i < n; ++i) {
+        const LongComplex x = toLong(a[i]), y = toLong(b[i]);
+        add[i] = ulpError(a[i] + b[i], x + y);
+        multiply[i] = ulpError(a[i] * b[i], x * y);
+        divide[i] = ulpError(a[i] / b[i], x / y);
+        amplitude[i] = ulpError(a[i].amplitude(), std::abs(x));
+        phase[i] = ulpError(a[i].phase(), std::arg(x));
+    }
+    record("a + b", 1.0, a, add);
+    record("a * b", 2.0, a, multiply);
+    record("a / b", 4.0, a, divide);
+    record("amplitude", 1.0, a, amplitude);
+    record("phase", 2.0, a, phase);
+}
+
+// f is checked against its long double counterpart, scalar and as the batch version on every backend
+static void measureFunction(const std::string& name, const std::vector<Complex>& inputs, double scalarBound,
+                            double batchBound, const std::function<Complex(const Complex&)>& f,
+                            const std::function<ComplexArray(const ComplexArray&)>& batch,
+                            const std::function<LongComplex(const LongComplex&)>& reference) {
+    std::vector<LongComplex> expected(inputs.size());
+    std::vector<double> errors(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        expected[i] = reference(toLong(inputs[i]));
+        errors[i] = ulpError(f(inputs[i]), expected[i]);
+    }
+    record(name, scalarBound, inputs, errors);
+
+    const Backend previous = ComplexArray::activeBackend();
+    for (Backend backend : {Backend::Scalar, Backend::Avx2, Backend::Avx512}) {
+        if (ComplexArray::forceBackend(backend) != backend) continue;
+        const ComplexArray output = batch(ComplexArray(inputs));
+        for (size_t i = 0; i < inputs.size(); ++i) errors[i] = ulpError(output[i], expected[i]);
+        const char* suffix = backend == Backend::Avx512 ? "avx512" : backend == Backend::Avx2 ? "avx2" : "scalar";
+        record(name + " [batch " + suffix + "]", batchBound, inputs, errors);
+    }
+    ComplexArray::forceBackend(previous);
+}
+
+static void measureFunctions(size_t n) {
+    const auto bounded = makeBounded(n, 20.0, 3), wide = makeOperands(n, 30, 4);
+    measureFunction(
+        "exp", bounded, 4.0, 8.0, [](const Complex& z) { return exp(z); },
+        [](const ComplexArray& z) { return exp(z); }, [](const LongComplex& z) { return std::exp(z); });
+    measureFunction(
+        "log", wide, 4.0, 8.0, [](const Complex& z) { return log(z); },
+        [](const ComplexArray& z) { return log(z); }, [](const LongComplex& z) { return std::log(z); });
+    measureFunction(
+        "sqrt", wide, 2.0, 4.0, [](const Complex& z) { return sqrt(z); },
+        [](const ComplexArray& z) { return sqrt(z); }, [](const LongComplex& z) { return std::sqrt(z); });
+    measureFunction(
+        "sin", bounded, 4.0, 8.0, [](const Complex& z) { return sin(z); },
+        [](const ComplexArray& z) { return sin(z); }, [](const LongComplex& z) { return std::sin(z); });
+    measureFunction(
+        "cos", bounded, 4.0, 8.0, [](const Complex& z) { return cos(z); },
+        [](const ComplexArray& z) { return cos(z); }, [](const LongComplex& z) { return std::cos(z); });
+}
+
+// element-wise ComplexArray arithmetic on every backend against the same references as the scalar operators
+static void measureArrayArithmetic(size_t n) {
+    const auto a = makeOperands(n, 30, 5), b = makeOperands(n, 30, 6);
+    const ComplexArray x(a), y(b);
+    const Backend previous = ComplexArray::activeBackend();
+    for (Backend backend : {Backend::Scalar, Backend::Avx2, Backend::Avx512}) {
+        if (ComplexArray::forceBackend(backend) != backend) continue;
+        const char* suffix = backend == Backend::Avx512 ? "avx512" : backend == Backend::Avx2 ? "avx2" : "scalar";
+        const ComplexArray product = x * y, quotient = x / y;
+        const auto amplitude = x.amplitude(), phase = x.phase();
+        std::vector<double> multiplyErrors(n), divideErrors(n), amplitudeErrors(n), phaseErrors(n);
+        for (size_t i = 0; i < n; ++i) {
+            const LongComplex p = toLong(a[i]), q = toLong(b[i]);
+            multiplyErrors[i] = ulpError(product[i], p * q);
+            divideErrors[i] = ulpError(quotient[i], p / q);
+            amplitudeErrors[i] = ulpError(amplitude[i], std::abs(p));
+            phaseErrors[i] = ulpError(phase[i], std::arg(p));
+        }
+        record(std::string("a * b [batch ") + suffix + "]", 2.0, a, multiplyErrors);
+        record(std::string("a / b [batch ") + suffix + "]", 4.0, a, divideErrors);
+        record(std::string("amplitude [batch ") + suffix + "]", 2.0, a, amplitudeErrors);
+        // the batch phase runs the polynomial atan2 kernel, so it gets the batch functions' doubled bound
+        record(std::string("phase [batch ") + suffix + "]", 4.0, a, phaseErrors);
+    }
+    ComplexArray::forceBackend(previous);
+}
+
+// NaN, infinite or finite: a batch result of another class than its reference is an error
+static int valueClass(double x) { return std::isnan(x) ? 0 : std::isinf(x) ? 1 : 2; }
+
+static double classError(double computed, double reference) {
+    return valueClass(computed) == valueClass(reference) ? 0.0 : std::numeric_limits<double>::infinity();
+}
+
+static double classError(const Complex& computed, const Complex& reference) {
+    return std::max(classError(computed.getReal(), reference.getReal()),
+                    classError(computed.getImag(), reference.getImag()));
+}
+
+// Every pair of ±0, ±inf, NaN, subnormals, DBL_MAX and ordinary parts through the batch operations. Only the
+// class of each result is compared: amplitude and phase against the long double std::abs and std::arg, the
+// products and quotients against the scalar Complex operators, whose formulas the kernels vectorize.
+static void measureArraySpecialValues() {
+    const double inf = std::numeric_limits<double>::infinity(), nan = std::numeric_limits<double>::quiet_NaN();
+    const double subnormal = std::numeric_limits<double>::denorm_min();
+    const double parts[] = {0.0, -0.0, inf, -inf, nan, subnormal, -3 * subnormal, 1e-310, DBL_MIN, 1.0, -2.5, DBL_MAX};
+    std::vector<Complex> a, b;
+    for (double re : parts) {
+        for (double im : parts) a.emplace_back(re, im);
+    }
+    // the same values in reverse as right-hand operands, skipping the zeros division rejects
+    for (size_t i = 0; b.size() < a.size(); ++i) {
+        const Complex& value = a[a.size() - 1 - i % a.size()];
+        if (value.getReal() != 0.0 || value.getImag() != 0.0) b.push_back(value);
+    }
+
+    const ComplexArray x(a), y(b);
+    const size_t n = a.size();
+    const Backend previous = ComplexArray::activeBackend();
+    for (Backend backend : {Backend::Scalar, Backend::Avx2, Backend::Avx512}) {
+        if (ComplexArray::forceBackend(backend) != backend) continue;
+        const char* suffix = backend == Backend::Avx512 ? "avx512" : backend == Backend::Avx2 ? "avx2" : "scalar";
+        const ComplexArray product = x * y, quotient = x / y;
+        const auto amplitude = x.amplitude(), phase = x.phase();
+        std::vector<double> multiplyErrors(n), divideErrors(n), amplitudeErrors(n), phaseErrors(n);
+        for (size_t i = 0; i < n; ++i) {
+            const LongComplex p = toLong(a[i]);
+            multiplyErrors[i] = classError(product[i], a[i] * b[i]);
+            divideErrors[i] = classError(quotient[i], a[i] / b[i]);
+            amplitudeErrors[i] = classError(amplitude[i], static_cast<double>(std::abs(p)));
+            phaseErrors[i] = classError(phase[i], static_cast<double>(std::arg(p)));
+        }
+        record(std::string("a * b [special ") + suffix + "]", 0.0, a, multiplyErrors);
+        record(std::string("a / b [special ") + suffix + "]", 0.0, a, divideErrors);
+        record(std::string("amplitude [special ") + suffix + "]", 0.0, a, amplitudeErrors);
+        record(std::string("phase [special ") + suffix + "]", 0.0, a, phaseErrors);
+    }
+    ComplexArray::forceBackend(previous);
+}
+
+int main(int argc, char** argv) {
+    const size_t samples = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    measureScalar(samples);
+    measureArrayArithmetic(samples);
+    measureArraySpecialValues();
+    measureFunctions(samples);
+
+    bool withinBounds = true;
+    std::printf("%-28s %12s %8s  %s\n", "operation", "max ulps", "bound", "worst input");
+    for (const auto& result : results) {
+        const bool ok = result.maxUlps <= result.bound;
+        withinBounds = withinBounds && ok;
+        std::printf("%-28s %12.3f %8.1f  (%.17g,%.17g)%s\n", result.name.c_str(), result.maxUlps, result.bound,
+                    result.worstInput.getReal(), result.worstInput.getImag(), ok ? "" : "  <-- exceeds bound");
+    }
+    std::printf("%zu samples per operation\n", samples);
+    return withinBounds ? 0 : 1;
+}
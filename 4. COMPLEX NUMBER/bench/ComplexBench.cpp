@@ -0,0 +1,356 @@
+// Run with --benchmark_format=json (or csv) for machine-readable output.
+#include <benchmark/benchmark.h>
+#include "Complex.h"
+#include "ComplexArray.h"
+#include "ComplexMath.h"
+#include "ComplexMatrix.h"
+#include "Fft.h"
+#include "PolarComplex.h"
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <vector>
+
+// The out-of-line variants reproduce the old Complex.cpp calls: one opaque call per operator,
+// which the optimizer can neither inline nor vectorize across.
+__attribute__((noinline)) static Complex& addAssignOutOfLine(Complex& c1, const Complex& c2) { return c1 += c2; }
+__attribute__((noinline)) static Complex multiplyOutOfLine(Complex c1, const Complex& c2) { return c1 *= c2; }
+
+static std::vector<Complex> makeSamples(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<Complex> samples;
+    samples.reserve(n);
+    for (size_t i = 0; i < n; ++i) samples.emplace_back(dist(rng), dist(rng));
+    return samples;
+}
+
+// sum of a[i] * b[i], the inner loop of correlation and FIR filtering
+static void BM_DotProductInline(benchmark::State& state) {
+    const auto a = makeSamples(state.range(0), 1), b = makeSamples(state.range(0), 2);
+    for (auto _ : state) {
+        Complex sum;
+        for (size_t i = 0; i < a.size(); ++i) sum += a[i] * b[i];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_DotProductOutOfLine(benchmark::State& state) {
+    const auto a = makeSamples(state.range(0), 1), b = makeSamples(state.range(0), 2);
+    for (auto _ : state) {
+        Complex sum;
+        for (size_t i = 0; i < a.size(); ++i) addAssignOutOfLine(sum, multiplyOutOfLine(a[i], b[i]));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// out[i] = a[i] * b[i]
+static void BM_MultiplyInline(benchmark::State& state) {
+    const auto a = makeSamples(state.range(0), 1), b = makeSamples(state.range(0), 2);
+    std::vector<Complex> out(a.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < a.size(); ++i) out[i] = a[i] * b[i];
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_MultiplyOutOfLine(benchmark::State& state) {
+    const auto a = makeSamples(state.range(0), 1), b = makeSamples(state.range(0), 2);
+    std::vector<Complex> out(a.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < a.size(); ++i) out[i] = multiplyOutOfLine(a[i], b[i]);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// unit-magnitude samples, so repeated in-place multiplication and division keep the values in range
+static std::vector<Complex> makeUnitSamples(size_t n, unsigned seed) {
+    auto samples = makeSamples(n, seed);
+    for (auto& sample : samples) sample /= sample.amplitude();
+    return samples;
+}
+
+//  Element-wise operations, AoS (std::vector<Complex>) against batch (ComplexArray).
+//  The batch versions work in place, as ComplexArray's operators do.
+
+static void BM_AddAos(benchmark::State& state) {
+    const auto a = makeSamples(state.range(0), 1), b = makeSamples(state.range(0), 2);
+    std::vector<Complex> out(a.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < a.size(); ++i) out[i] = a[i] + b[i];
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// += then -=, two operations per element
+static void BM_AddBatch(benchmark::State& state) {
+    ComplexArray x(makeSamples(state.range(0), 1));
+    const ComplexArray b(makeSamples(state.range(0), 2));
+    for (auto _ : state) {
+        x += b;
+        x -= b;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+
+static void BM_MultiplyBatch(benchmark::State& state) {
+    ComplexArray x(makeSamples(state.range(0), 1));
+    const ComplexArray u(makeUnitSamples(state.range(0), 2));
+    for (auto _ : state) {
+        x *= u;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_DivideAos(benchmark::State& state) {
+    const auto a = makeSamples(state.range(0), 1), b = makeSamples(state.range(0), 2);
+    std::vector<Complex> out(a.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < a.size(); ++i) out[i] = a[i] / b[i];
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_DivideBatch(benchmark::State& state) {
+    ComplexArray x(makeSamples(state.range(0), 1));
+    const ComplexArray u(makeUnitSamples(state.range(0), 2));
+    for (auto _ : state) {
+        x /= u;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// amplitude() is std::hypot per element; the batch kernel scales by the larger part instead
+static void BM_AmplitudeAos(benchmark::State& state) {
+    const auto a = makeSamples(state.range(0), 1);
+    std::vector<double> out(a.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < a.size(); ++i) out[i] = a[i].amplitude();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_AmplitudeBatch(benchmark::State& state) {
+    const ComplexArray x(makeSamples(state.range(0), 1));
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        x.amplitude(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PhaseAos(benchmark::State& state) {
+    const auto a = makeSamples(state.range(0), 1);
+    std::vector<double> out(a.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < a.size(); ++i) out[i] = a[i].phase();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PhaseBatch(benchmark::State& state) {
+    const ComplexArray x(makeSamples(state.range(0), 1));
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        x.phase(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// one string per value; BM_FormatBulk below is the batch counterpart
+static void BM_ToString(benchmark::State& state) {
+    const auto a = makeSamples(state.range(0), 1);
+    for (auto _ : state) {
+        for (const auto& c : a) benchmark::DoNotOptimize(c.toString());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// range(0): transform length; the plan is built outside the timed loop
+static void BM_FftForward(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const auto plan = FftPlan::get(n);
+    const auto in = makeSamples(n, 3);
+    std::vector<Complex> out(n);
+    for (auto _ : state) {
+        plan->forward(in.data(), out.data(), 1);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_RealFft(benchmark::State& state) {
+    std::vector<double> in;
+    for (const auto& sample : makeSamples(state.range(0), 4)) in.push_back(sample.getReal());
+    for (auto _ : state) benchmark::DoNotOptimize(rfft(in));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// exp over every element: the scalar function in a loop against the batch kernel
+static void BM_ExpScalar(benchmark::State& state) {
+    const auto in = makeSamples(state.range(0), 5);
+    std::vector<Complex> out(in.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < in.size(); ++i) out[i] = exp(in[i]);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ExpBatch(benchmark::State& state) {
+    const ComplexArray in(makeSamples(state.range(0), 5));
+    for (auto _ : state) benchmark::DoNotOptimize(exp(in));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// text output of a block of samples: one ostringstream per value, as toString used to do, against the
+// to_chars based bulk writer
+static void BM_FormatOstringstream(benchmark::State& state) {
+    const auto values = makeSamples(state.range(0), 6);
+    for (auto _ : state) {
+        std::ostringstream out;
+        for (const auto& c : values) {
+            std::ostringstream element;
+            element << std::fixed << std::setprecision(2) << "(" << c.getReal() << "," << c.getImag() << ")";
+            out << element.str() << '\n';
+        }
+        benchmark::DoNotOptimize(out.str());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_FormatBulk(benchmark::State& state) {
+    const auto values = makeSamples(state.range(0), 6);
+    for (auto _ : state) {
+        std::ostringstream out;
+        writeComplex(out, values.data(), values.size());
+        benchmark::DoNotOptimize(out.str());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// every value multiplied by the same rotation, in Cartesian and in polar form
+static void BM_RotateCartesian(benchmark::State& state) {
+    auto a = makeSamples(state.range(0), 1);
+    const Complex rotation(std::cos(0.01), std::sin(0.01));
+    for (auto _ : state) {
+        for (auto& c : a) c *= rotation;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_RotatePolar(benchmark::State& state) {
+    std::vector<PolarComplex> a;
+    for (const auto& c : makeSamples(state.range(0), 1)) a.emplace_back(c);
+    const PolarComplex rotation(1.0, 0.01);
+    for (auto _ : state) {
+        for (auto& p : a) p *= rotation;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ToPolarScalar(benchmark::State& state) {
+    const auto a = makeSamples(state.range(0), 1);
+    std::vector<double> magnitude(a.size()), angle(a.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            magnitude[i] = a[i].amplitude();
+            angle[i] = a[i].phase();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ToPolarBatch(benchmark::State& state) {
+    const ComplexArray x(makeSamples(state.range(0), 1));
+    std::vector<double> magnitude(x.size()), angle(x.size());
+    for (auto _ : state) {
+        toPolar(x, magnitude.data(), angle.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_FromPolarScalar(benchmark::State& state) {
+    const ComplexArray x(makeSamples(state.range(0), 1));
+    std::vector<double> magnitude(x.size()), angle(x.size());
+    toPolar(x, magnitude.data(), angle.data());
+    std::vector<Complex> out(x.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < out.size(); ++i) out[i] = PolarComplex(magnitude[i], angle[i]).toComplex();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_FromPolarBatch(benchmark::State& state) {
+    const ComplexArray x(makeSamples(state.range(0), 1));
+    std::vector<double> magnitude(x.size()), angle(x.size());
+    toPolar(x, magnitude.data(), angle.data());
+    for (auto _ : state) benchmark::DoNotOptimize(fromPolar(magnitude.data(), angle.data(), x.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// square complex GEMM on one thread; range(0): size, range(1): 0 for 4M, 1 for 3M.
+// items are complex multiply-adds, n^3 per product.
+static void BM_ComplexGemm(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const auto algorithm = state.range(1) ? ComplexMatrix::Algorithm::ThreeM : ComplexMatrix::Algorithm::FourM;
+    const auto a = makeSamples(n * n, 7), b = makeSamples(n * n, 8);
+    const ComplexMatrix ma(n, n, a.data()), mb(n, n, b.data());
+    for (auto _ : state) benchmark::DoNotOptimize(ComplexMatrix::multiply(ma, mb, algorithm, 1));
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0) * state.range(0));
+}
+
+BENCHMARK(BM_DotProductInline)->Arg(4096);
+BENCHMARK(BM_DotProductOutOfLine)->Arg(4096);
+BENCHMARK(BM_MultiplyInline)->Arg(4096);
+BENCHMARK(BM_MultiplyOutOfLine)->Arg(4096);
+
+BENCHMARK(BM_AddAos)->Arg(4096);
+BENCHMARK(BM_AddBatch)->Arg(4096);
+BENCHMARK(BM_MultiplyBatch)->Arg(4096);
+BENCHMARK(BM_DivideAos)->Arg(4096);
+BENCHMARK(BM_DivideBatch)->Arg(4096);
+BENCHMARK(BM_AmplitudeAos)->Arg(4096);
+BENCHMARK(BM_AmplitudeBatch)->Arg(4096);
+BENCHMARK(BM_PhaseAos)->Arg(4096);
+BENCHMARK(BM_PhaseBatch)->Arg(4096);
+BENCHMARK(BM_ToString)->Arg(4096);
+
+BENCHMARK(BM_ExpScalar)->Arg(4096);
+BENCHMARK(BM_ExpBatch)->Arg(4096);
+
+BENCHMARK(BM_FormatOstringstream)->Arg(4096);
+BENCHMARK(BM_FormatBulk)->Arg(4096);
+
+BENCHMARK(BM_RotateCartesian)->Arg(4096);
+BENCHMARK(BM_RotatePolar)->Arg(4096);
+BENCHMARK(BM_ToPolarScalar)->Arg(4096);
+BENCHMARK(BM_ToPolarBatch)->Arg(4096);
+BENCHMARK(BM_FromPolarScalar)->Arg(4096);
+BENCHMARK(BM_FromPolarBatch)->Arg(4096);
+
+BENCHMARK(BM_ComplexGemm)->Args({64, 0})->Args({512, 0})->Args({512, 1});
+
+BENCHMARK(BM_FftForward)->Arg(1024)->Arg(1000)->Arg(4096)->Arg(3 * 5 * 4096)->Arg(1 << 20)->Arg(1031);
+BENCHMARK(BM_RealFft)->Arg(1024)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
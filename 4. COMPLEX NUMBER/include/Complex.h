@@ -1,46 +1,112 @@
 #pragma once
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <iosfwd>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 
+// Arithmetic is defined here so it can be inlined and used in constant expressions.
+// Copying is left to the compiler, which keeps the type trivially copyable.
 class Complex {
 private:
     double Real;
     double Imag;
 
 public:
-    Complex();
-    Complex(double value);     // converting constructor
-    Complex(double Real, double Imag);
+    constexpr Complex() : Real(0.0), Imag(0.0) {}
+    constexpr Complex(double value) : Real(value), Imag(0.0) {}     // converting constructor
+    constexpr Complex(double Real, double Imag) : Real(Real), Imag(Imag) {}
 
-    Complex& operator=(const Complex& c);
-    Complex& operator=(double value);
+    constexpr Complex& operator=(double value) {
+        Real = value;
+        Imag = 0.0;
+        return *this;
+    }
 
-    Complex operator-() const;
+    constexpr Complex operator-() const { return Complex(-Real, -Imag); }
 
-    Complex& operator+=(const Complex& c2);
-    Complex& operator-=(const Complex& c2);
-    Complex& operator*=(const Complex& c2);
-    Complex& operator/=(const Complex& c2); // can throw exception
+    constexpr Complex& operator+=(const Complex& c2) {
+        Real += c2.Real;
+        Imag += c2.Imag;
+        return *this;
+    }
 
-    double amplitude() const;
-    double phase() const;
-    bool isReal(double epsilon = 1e-10) const;
-    bool isImaginary(double epsilon = 1e-10) const;
-    Complex conjugate() const;
-    std::string toString() const;
-    double getReal() const { return Real; }
-    double getImag() const { return Imag; }
-    void setReal(double r) { Real = r; }
-    void setImag(double i) { Imag = i; }
+    constexpr Complex& operator-=(const Complex& c2) {
+        Real -= c2.Real;
+        Imag -= c2.Imag;
+        return *this;
+    }
 
+    constexpr Complex& operator*=(const Complex& c2) {
+        double newReal = Real * c2.Real - Imag * c2.Imag;
+        double newImag = Real * c2.Imag + Imag * c2.Real;
+        Real = newReal;
+        Imag = newImag;
+        return *this;
+    }
 
+    // Smith's algorithm: scaling by the larger part of c2 keeps |c2|^2 from overflowing or underflowing.
+    // can throw exception
+    constexpr Complex& operator/=(const Complex& c2) {
+        if (c2.Real == 0.0 && c2.Imag == 0.0) {
+            throw std::runtime_error("Division by zero");
+        }
+        const double absReal = c2.Real < 0.0 ? -c2.Real : c2.Real;
+        const double absImag = c2.Imag < 0.0 ? -c2.Imag : c2.Imag;
+        double newReal = 0.0, newImag = 0.0;
+        if (absReal >= absImag) {
+            const double ratio = c2.Imag / c2.Real;
+            const double scale = 1.0 / (c2.Real + c2.Imag * ratio);
+            newReal = (Real + Imag * ratio) * scale;
+            newImag = (Imag - Real * ratio) * scale;
+        }
+        else {
+            const double ratio = c2.Real / c2.Imag;
+            const double scale = 1.0 / (c2.Real * ratio + c2.Imag);
+            newReal = (Real * ratio + Imag) * scale;
+            newImag = (Imag * ratio - Real) * scale;
+        }
+        Real = newReal;
+        Imag = newImag;
+        return *this;
+    }
+
+    double amplitude() const { return std::hypot(Real, Imag); }
+    double phase() const { return std::atan2(Imag, Real); }
+    constexpr bool isReal(double epsilon = 1e-10) const { return -epsilon < Imag && Imag < epsilon; }
+    constexpr bool isImaginary(double epsilon = 1e-10) const { return -epsilon < Real && Real < epsilon; }
+    constexpr Complex conjugate() const { return Complex(Real, -Imag); }
+    // "(re,im)" with both parts in fixed notation, as written by operator<< (which uses precision 2)
+    std::string toString(int precision = 2) const;
+    // Writes the toString representation into [first, last). Same contract as std::to_chars.
+    std::to_chars_result toChars(char* first, char* last, int precision = 2) const;
+    // Text of the form "(re,im)", spaces allowed around the parts. Same contract as std::from_chars.
+    static std::from_chars_result fromChars(const char* first, const char* last, Complex& result);
+    // Throws std::invalid_argument unless the whole text is a complex number.
+    static Complex parse(std::string_view text);
+    constexpr double getReal() const { return Real; }
+    constexpr double getImag() const { return Imag; }
+    constexpr void setReal(double r) { Real = r; }
+    constexpr void setImag(double i) { Imag = i; }
 };
 
-Complex operator+(Complex c1, const Complex& c2);
-Complex operator-(Complex c1, const Complex& c2);
-Complex operator*(Complex c1, const Complex& c2);
-Complex operator/(Complex c1, const Complex& c2);
+constexpr Complex operator+(Complex c1, const Complex& c2) { return c1 += c2; }
+constexpr Complex operator-(Complex c1, const Complex& c2) { return c1 -= c2; }
+constexpr Complex operator*(Complex c1, const Complex& c2) { return c1 *= c2; }
+constexpr Complex operator/(Complex c1, const Complex& c2) { return c1 /= c2; }
+
+constexpr bool operator==(const Complex& c1, const Complex& c2) {
+    // |a - b| < 1e-10, written without std::fabs, which is not constexpr
+    auto isNearEq = [](double a, double b) { return a - b < 1e-10 && b - a < 1e-10; };
+    return isNearEq(c1.getReal(), c2.getReal()) && isNearEq(c1.getImag(), c2.getImag());
+}
+
+constexpr bool operator!=(const Complex& c1, const Complex& c2) { return !(c1 == c2); }
 
-bool operator==(const Complex& c1, const Complex& c2);
-bool operator!=(const Complex& c1, const Complex& c2);
+std::ostream& operator<<(std::ostream& out, const Complex& c);
 
-std::ostream& operator<<(std::ostream& out, const Complex& c);
\ No newline at end of file
+// Writes count values, each followed by separator, through one buffer flushed in large blocks.
+std::ostream& writeComplex(std::ostream& out, const Complex* values, size_t count, int precision = 2,
+                           char separator = '\n');
@@ -0,0 +1,76 @@
+#pragma once
+#include "Complex.h"
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Allocator returning 64-byte aligned storage, so every SIMD width can use aligned rows.
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+    static constexpr std::align_val_t ALIGNMENT{64};
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), ALIGNMENT)); }
+    void deallocate(T* p, size_t) { ::operator delete(p, ALIGNMENT); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+// Array of complex numbers in structure-of-arrays layout: all real parts in one buffer and all
+// imaginary parts in another. Element-wise operations run on AVX-512 or AVX2 when the CPU supports it.
+class ComplexArray {
+public:
+    enum class SimdBackend { Scalar, Avx2, Avx512 };
+
+    ComplexArray() = default;
+    explicit ComplexArray(size_t size);
+    explicit ComplexArray(const std::vector<Complex>& values);
+
+    std::vector<Complex> toVector() const;
+
+    size_t size() const { return realParts.size(); }
+    void resize(size_t size);
+
+    Complex operator[](size_t index) const { return Complex(realParts[index], imagParts[index]); }
+    void set(size_t index, const Complex& value);
+
+    double* real() { return realParts.data(); }
+    const double* real() const { return realParts.data(); }
+    double* imag() { return imagParts.data(); }
+    const double* imag() const { return imagParts.data(); }
+
+    // element-wise, the arrays must have the same size
+    ComplexArray& operator+=(const ComplexArray& other);
+    ComplexArray& operator-=(const ComplexArray& other);
+    ComplexArray& operator*=(const ComplexArray& other);
+    ComplexArray& operator/=(const ComplexArray& other); // can throw exception
+
+    ComplexArray& conjugate();
+    void amplitude(double* out) const;
+    void phase(double* out) const;
+    std::vector<double> amplitude() const;
+    std::vector<double> phase() const;
+
+    // Backend chosen at startup from the CPU features. forceBackend() is meant for tests and benchmarks;
+    // it falls back to the best supported backend below the requested one and returns the one selected.
+    static SimdBackend activeBackend();
+    static SimdBackend forceBackend(SimdBackend backend);
+
+private:
+    std::vector<double, AlignedAllocator<double>> realParts;
+    std::vector<double, AlignedAllocator<double>> imagParts;
+
+    void throwIfSizeMismatch(const ComplexArray& other) const;
+};
+
+ComplexArray operator+(ComplexArray a1, const ComplexArray& a2);
+ComplexArray operator-(ComplexArray a1, const ComplexArray& a2);
+ComplexArray operator*(ComplexArray a1, const ComplexArray& a2);
+ComplexArray operator/(ComplexArray a1, const ComplexArray& a2);
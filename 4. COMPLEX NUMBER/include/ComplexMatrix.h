@@ -0,0 +1,100 @@
+#pragma once
+#include "Complex.h"
+#include "ComplexArray.h"
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// Dense complex matrix stored as two row-major planes, one for the real parts and one for the imaginary
+// parts. Copies share the planes until one of them is written to, the same copy-on-write scheme as Matrix
+// in "6. MATRIX", and errors follow ComplexArray: std::invalid_argument for bad or mismatched dimensions,
+// std::out_of_range for bad indices.
+class ComplexMatrix {
+public:
+    class Ref;
+
+    // 4M: four real products per complex one. 3M (Gauss): three products and more additions, about 25%
+    // less arithmetic, but the imaginary parts lose accuracy when |re| and |im| differ a lot.
+    enum class Algorithm { FourM, ThreeM };
+
+    // products with at least this many complex multiply-adds use several threads unless a count is given
+    static constexpr size_t PARALLEL_THRESHOLD = size_t(1) << 21;
+
+    explicit ComplexMatrix(size_t rows = 0, size_t cols = 0);
+    ComplexMatrix(size_t rows, size_t cols, const Complex& initValue);
+    ComplexMatrix(size_t rows, size_t cols, const Complex* data); // data is row-major
+    ComplexMatrix(const ComplexMatrix& other);
+
+    ComplexMatrix& operator=(ComplexMatrix other);
+    ~ComplexMatrix();
+
+    size_t getRows() const { return sharedData ? sharedData->rows : 0; }
+    size_t getColumns() const { return sharedData ? sharedData->cols : 0; }
+
+    Complex operator()(size_t row, size_t col) const;
+    Ref operator()(size_t row, size_t col);
+
+    // row-major planes with getColumns() values per row; null for an empty matrix
+    const double* real() const { return sharedData ? sharedData->realParts.data() : nullptr; }
+    const double* imag() const { return sharedData ? sharedData->imagParts.data() : nullptr; }
+
+    ComplexMatrix& operator+=(const ComplexMatrix& other);
+    ComplexMatrix& operator-=(const ComplexMatrix& other);
+    ComplexMatrix& operator*=(const ComplexMatrix& other);
+
+    bool operator==(const ComplexMatrix& other) const;
+    bool operator!=(const ComplexMatrix& other) const;
+
+    ComplexMatrix transpose() const;
+    // transpose with every element conjugated (A^H)
+    ComplexMatrix conjugateTranspose() const;
+
+    // a * b with a cache-blocked kernel built for ComplexArray::activeBackend().
+    // threads == 0 picks std::thread::hardware_concurrency() for large products and 1 otherwise.
+    static ComplexMatrix multiply(const ComplexMatrix& a, const ComplexMatrix& b,
+                                  Algorithm algorithm = Algorithm::FourM, unsigned threads = 0);
+
+    friend std::ostream& operator<<(std::ostream& out, const ComplexMatrix& matrix);
+
+private:
+    struct MatrixData {
+        size_t rows;
+        size_t cols;
+        std::vector<double, AlignedAllocator<double>> realParts;
+        std::vector<double, AlignedAllocator<double>> imagParts;
+        size_t refCount;
+
+        MatrixData(size_t rows, size_t cols);
+    };
+
+    MatrixData* sharedData;
+
+    void swapContents(ComplexMatrix& other);
+    void detachIfNotUniqueOwner();
+    void validateIndex(size_t row, size_t col) const;
+    void throwIfDimensionsMismatch(const ComplexMatrix& other, const char* operation) const;
+    Complex read(size_t row, size_t col) const;
+    void write(size_t row, size_t col, const Complex& value);
+    double* mutableReal() { return sharedData->realParts.data(); }
+    double* mutableImag() { return sharedData->imagParts.data(); }
+    ComplexMatrix transposed(bool conjugate) const;
+};
+
+class ComplexMatrix::Ref {
+    friend class ComplexMatrix;
+    ComplexMatrix& m;
+    size_t row, col;
+    Ref(ComplexMatrix& matrix, size_t r, size_t c) : m(matrix), row(r), col(c) { m.validateIndex(r, c); }
+
+public:
+    operator Complex() const { return m.read(row, col); }
+
+    ComplexMatrix::Ref& operator=(const Complex& value) {
+        m.write(row, col, value);
+        return *this;
+    }
+};
+
+ComplexMatrix operator+(const ComplexMatrix& m1, const ComplexMatrix& m2);
+ComplexMatrix operator-(const ComplexMatrix& m1, const ComplexMatrix& m2);
+ComplexMatrix operator*(const ComplexMatrix& m1, const ComplexMatrix& m2);
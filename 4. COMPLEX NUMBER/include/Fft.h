@@ -0,0 +1,55 @@
+#pragma once
+#include "Complex.h"
+#include "ComplexArray.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Precomputed mixed-radix FFT of one length. Lengths are factored into radix 4, 2, 3 and 5 stages; any
+// prime factor left over gets a generic O(p^2) stage, so every length works, just slower.
+// Forward transform: X[k] = sum x[j] * exp(-2*pi*i*j*k/n). The inverse is scaled by 1/n.
+class FftPlan {
+public:
+    // transforms at least this long use several threads unless a thread count is given
+    static constexpr size_t PARALLEL_THRESHOLD = size_t(1) << 16;
+
+    explicit FftPlan(size_t size);
+
+    // Plans are immutable and shared; get() builds one the first time a length is asked for.
+    static std::shared_ptr<const FftPlan> get(size_t size);
+    static void clearCache();
+
+    size_t size() const { return n; }
+
+    // in and out hold size() values each and may be the same buffer.
+    // threads == 0 picks std::thread::hardware_concurrency() for long transforms and 1 otherwise.
+    void forward(const Complex* in, Complex* out, unsigned threads = 0) const;
+    void inverse(const Complex* in, Complex* out, unsigned threads = 0) const;
+
+private:
+    struct Stage {
+        size_t radix;
+        size_t length; // length of each sub-transform combined by this stage
+    };
+
+    size_t n;
+    std::vector<Stage> stages;
+    std::vector<Complex> twiddles; // exp(-2*pi*i*j/n) for j < n
+
+    void transform(Complex* out, const Complex* in, size_t fstride, size_t stage) const;
+    void transformParallel(Complex* out, const Complex* in, unsigned threads) const;
+    void butterfly(Complex* out, size_t fstride, size_t stage, size_t begin, size_t end) const;
+};
+
+std::vector<Complex> fft(const std::vector<Complex>& input);
+std::vector<Complex> ifft(const std::vector<Complex>& input);
+
+// The SoA overloads gather into interleaved storage for the transform and scatter the result back.
+ComplexArray fft(const ComplexArray& input);
+ComplexArray ifft(const ComplexArray& input);
+
+// Transform of real input: returns the size() / 2 + 1 non-redundant bins. Even lengths run a complex
+// transform of half the length.
+std::vector<Complex> rfft(const std::vector<double>& input);
+// Inverse of rfft(); size is the length of the real signal, spectrum holds size / 2 + 1 bins.
+std::vector<double> irfft(const std::vector<Complex>& spectrum, size_t size);
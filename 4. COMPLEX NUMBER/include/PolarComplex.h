@@ -0,0 +1,90 @@
+#pragma once
+#include "Complex.h"
+#include <cmath>
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+
+// Complex number in polar form, magnitude * exp(i * angle). Multiplication, division and powers act on
+// the two fields directly, so a multiply is one multiplication and one addition. The angle is kept in
+// [-pi, pi]. The Cartesian form is computed on the first toComplex() call and cached until the value
+// changes; the cache is not synchronized, so a PolarComplex shared between threads must not be converted
+// concurrently.
+class PolarComplex {
+private:
+    double Magnitude;
+    double Angle;
+    mutable Complex cartesian;
+    mutable bool cartesianValid = false;
+
+    // a sum or difference of two angles in [-pi, pi] is at most one turn off
+    static double wrapOnce(double angle) {
+        if (angle > M_PI) return angle - 2.0 * M_PI;
+        if (angle < -M_PI) return angle + 2.0 * M_PI;
+        return angle;
+    }
+
+public:
+    PolarComplex() : Magnitude(0.0), Angle(0.0) {}
+    // can throw exception: the magnitude must be a non-negative number
+    PolarComplex(double magnitude, double angle) : Magnitude(magnitude), Angle(std::remainder(angle, 2.0 * M_PI)) {
+        if (!(magnitude >= 0.0)) {
+            throw std::invalid_argument("Magnitude must be non-negative");
+        }
+    }
+    explicit PolarComplex(const Complex& c) : Magnitude(c.amplitude()), Angle(c.phase()), cartesian(c) {
+        cartesianValid = true;
+    }
+
+    PolarComplex& operator*=(const PolarComplex& p2) {
+        Magnitude *= p2.Magnitude;
+        Angle = wrapOnce(Angle + p2.Angle);
+        cartesianValid = false;
+        return *this;
+    }
+
+    // can throw exception
+    PolarComplex& operator/=(const PolarComplex& p2) {
+        if (p2.Magnitude == 0.0) {
+            throw std::runtime_error("Division by zero");
+        }
+        Magnitude /= p2.Magnitude;
+        Angle = wrapOnce(Angle - p2.Angle);
+        cartesianValid = false;
+        return *this;
+    }
+
+    // principal value: magnitude^exponent * exp(i * angle * exponent)
+    PolarComplex pow(double exponent) const { return PolarComplex(std::pow(Magnitude, exponent), Angle * exponent); }
+
+    PolarComplex conjugate() const { return PolarComplex(Magnitude, -Angle); }
+    PolarComplex inverse() const { return PolarComplex(1.0, 0.0) /= *this; }
+
+    double magnitude() const { return Magnitude; }
+    double angle() const { return Angle; }
+
+    const Complex& toComplex() const {
+        if (!cartesianValid) {
+            cartesian = Complex(Magnitude * std::cos(Angle), Magnitude * std::sin(Angle));
+            cartesianValid = true;
+        }
+        return cartesian;
+    }
+
+    // "r*exp(ai)" with both numbers fixed to two decimals
+    std::string toString() const;
+};
+
+inline PolarComplex operator*(PolarComplex p1, const PolarComplex& p2) { return p1 *= p2; }
+inline PolarComplex operator/(PolarComplex p1, const PolarComplex& p2) { return p1 /= p2; }
+
+// same tolerance as Complex; all angles of a zero magnitude are equal
+inline bool operator==(const PolarComplex& p1, const PolarComplex& p2) {
+    auto isNearEq = [](double a, double b) { return std::fabs(a - b) < 1e-10; };
+    if (!isNearEq(p1.magnitude(), p2.magnitude())) return false;
+    return p1.magnitude() == 0.0 || isNearEq(std::remainder(p1.angle() - p2.angle(), 2.0 * M_PI), 0.0);
+}
+
+inline bool operator!=(const PolarComplex& p1, const PolarComplex& p2) { return !(p1 == p2); }
+
+std::ostream& operator<<(std::ostream& out, const PolarComplex& p);
@@ -1,115 +1,102 @@
 #include "../include/Complex.h"
-#include <cmath>
-#include <iomanip>
+#include <cstring>
 #include <ostream>
-#include <stdexcept>
-#include <sstream>
+#include <system_error>
+#include <vector>
 
-Complex::Complex() {
-    Real = 0.0;
-    Imag = 0.0;
-}
-
-Complex::Complex(double value) {
-    Real = value;
-    Imag = 0.0;
-}
-
-Complex::Complex(double Real, double Imag) {
-    this->Real = Real;
-    this->Imag = Imag;
-}
-
-Complex& Complex::operator=(const Complex& c) {
-    Real = c.Real;
-    Imag = c.Imag;
-    return *this;
-}
+// fits "(re,im)" at the default precision for every finite double, 309 integer digits included
+static const size_t FORMAT_BUFFER_SIZE = 640;
+// block size of writeComplex
+static const size_t WRITE_BUFFER_SIZE = 1 << 16;
 
-Complex& Complex::operator=(double value) {
-    Real = value;
-    Imag = 0.0;
-    return *this;
+static std::to_chars_result appendChar(char* first, char* last, char c) {
+    if (first == last) return {last, std::errc::value_too_large};
+    *first = c;
+    return {first + 1, std::errc()};
 }
 
-Complex Complex::operator-() const {
-    return Complex(-Real, -Imag);
+std::to_chars_result Complex::toChars(char* first, char* last, int precision) const {
+    auto result = appendChar(first, last, '(');
+    if (result.ec == std::errc()) result = std::to_chars(result.ptr, last, Real, std::chars_format::fixed, precision);
+    if (result.ec == std::errc()) result = appendChar(result.ptr, last, ',');
+    if (result.ec == std::errc()) result = std::to_chars(result.ptr, last, Imag, std::chars_format::fixed, precision);
+    if (result.ec == std::errc()) result = appendChar(result.ptr, last, ')');
+    return result;
 }
 
-Complex& Complex::operator+=(const Complex& c2) {
-    Real += c2.Real;
-    Imag += c2.Imag;
-    return *this;
-}
+std::string Complex::toString(int precision) const {
+    char buffer[FORMAT_BUFFER_SIZE];
+    auto result = toChars(buffer, buffer + sizeof(buffer), precision);
+    if (result.ec == std::errc()) return std::string(buffer, result.ptr);
 
-Complex& Complex::operator-=(const Complex& c2) {
-    Real -= c2.Real;
-    Imag -= c2.Imag;
-    return *this;
+    // only reached with a large precision
+    std::vector<char> large(2 * (FORMAT_BUFFER_SIZE + static_cast<size_t>(precision)));
+    result = toChars(large.data(), large.data() + large.size(), precision);
+    return std::string(large.data(), result.ptr);
 }
 
-Complex& Complex::operator*=(const Complex& c2) {
-    double newReal = Real * c2.Real - Imag * c2.Imag;
-    double newImag = Real * c2.Imag + Imag * c2.Real;
-    Real = newReal;
-    Imag = newImag;
-    return *this;
-}
-
-Complex& Complex::operator/=(const Complex& c2) {
-    double denom = c2.Real * c2.Real + c2.Imag * c2.Imag;
-    if (denom == 0.0) {
-        throw std::runtime_error("Division by zero");
+std::ostream& operator<<(std::ostream& out, const Complex& c) {
+    char buffer[FORMAT_BUFFER_SIZE];
+    const auto result = c.toChars(buffer, buffer + sizeof(buffer));
+    return out << std::string_view(buffer, result.ptr - buffer);
+}
+
+std::ostream& writeComplex(std::ostream& out, const Complex* values, size_t count, int precision, char separator) {
+    std::vector<char> buffer(WRITE_BUFFER_SIZE);
+    char* const first = buffer.data();
+    char* const last = first + buffer.size();
+    char* ptr = first;
+    for (size_t i = 0; i < count; ++i) {
+        auto result = values[i].toChars(ptr, last, precision);
+        if (result.ec == std::errc() && result.ptr != last) {
+            *result.ptr = separator;
+            ptr = result.ptr + 1;
+            continue;
+        }
+        // no room left: flush and retry on an empty buffer
+        out.write(first, ptr - first);
+        ptr = first;
+        result = values[i].toChars(ptr, last - 1, precision);
+        if (result.ec == std::errc()) {
+            *result.ptr = separator;
+            ptr = result.ptr + 1;
+        }
+        else {
+            out << values[i].toString(precision) << separator;
+        }
     }
-    double newReal = (Real * c2.Real + Imag * c2.Imag) / denom;
-    double newImag = (Imag * c2.Real - Real * c2.Imag) / denom;
-    Real = newReal;
-    Imag = newImag;
-    return *this;
-}
-
-//  Utility functions
-double Complex::amplitude() const {
-    return std::hypot(Real, Imag);
-}
-
-double Complex::phase() const {
-    return std::atan2(Imag, Real);
-}
-bool Complex::isReal(double epsilon) const {
-    return std::fabs(Imag) < epsilon;
-}
-
-bool Complex::isImaginary(double epsilon) const {
-    return std::fabs(Real) < epsilon;
-}
-Complex Complex::conjugate() const {
-    return Complex(Real, -Imag);
-}
-
-std::string Complex::toString() const {
-    std::ostringstream output;
-    output << std::fixed << std::setprecision(2);
-    output << "(" << Real << "," << Imag << ")";
-    return output.str();
-}
-// non member 
-Complex operator+(Complex c1, const Complex& c2) { return c1 += c2; }
-Complex operator-(Complex c1, const Complex& c2) { return c1 -= c2; }
-Complex operator*(Complex c1, const Complex& c2) { return c1 *= c2; }
-Complex operator/(Complex c1, const Complex& c2) {return c1 /= c2;}
-
-
-static inline bool isNearEq(double a, double b, double eps = 1e-10) {
-    return std::fabs(a - b) < eps;
-}
-
-bool operator==(const Complex& c1, const Complex& c2) {
-    return  isNearEq(c1.getReal(), c2.getReal()) && isNearEq(c1.getImag(), c2.getImag());
+    return out.write(first, ptr - first);
+}
+
+static const char* skipSpaces(const char* first, const char* last) {
+    while (first != last && (*first == ' ' || *first == '\t')) ++first;
+    return first;
+}
+
+std::from_chars_result Complex::fromChars(const char* first, const char* last, Complex& result) {
+    const std::from_chars_result invalid{first, std::errc::invalid_argument};
+    double parts[2];
+    const char* ptr = skipSpaces(first, last);
+    for (int i = 0; i < 2; ++i) {
+        const char opening = i == 0 ? '(' : ',';
+        if (ptr == last || *ptr != opening) return invalid;
+        ptr = skipSpaces(ptr + 1, last);
+        const auto number = std::from_chars(ptr, last, parts[i]);
+        if (number.ec == std::errc::invalid_argument) return invalid;
+        if (number.ec != std::errc()) return {first, number.ec};
+        ptr = skipSpaces(number.ptr, last);
+    }
+    if (ptr == last || *ptr != ')') return invalid;
+    result = Complex(parts[0], parts[1]);
+    return {ptr + 1, std::errc()};
 }
 
-bool operator!=(const Complex& c1, const Complex& c2) { return !(c1 == c2); }
-
-std::ostream& operator<<(std::ostream& out, const Complex& c) {
-    return out << c.toString();
+Complex Complex::parse(std::string_view text) {
+    Complex result;
+    const char* last = text.data() + text.size();
+    const auto parsed = fromChars(text.data(), last, result);
+    if (parsed.ec != std::errc() || skipSpaces(parsed.ptr, last) != last) {
+        throw std::invalid_argument("invalid complex number: " + std::string(text));
+    }
+    return result;
 }
@@ -0,0 +1,391 @@
+#include "../include/ComplexArray.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define COMPLEX_ARRAY_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// Kernels work on raw rows; a* rows are updated in place, b* rows are the right-hand operand.
+struct ComplexKernels {
+    void (*add)(double* ar, double* ai, const double* br, const double* bi, size_t n);
+    void (*subtract)(double* ar, double* ai, const double* br, const double* bi, size_t n);
+    void (*multiply)(double* ar, double* ai, const double* br, const double* bi, size_t n);
+    void (*divide)(double* ar, double* ai, const double* br, const double* bi, size_t n);
+    void (*negate)(double* values, size_t n);
+    void (*amplitude)(const double* re, const double* im, double* out, size_t n);
+};
+
+//  Scalar kernels, also used for the tails the vector kernels leave behind
+static void addScalar(double* ar, double* ai, const double* br, const double* bi, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        ar[i] += br[i];
+        ai[i] += bi[i];
+    }
+}
+
+static void subtractScalar(double* ar, double* ai, const double* br, const double* bi, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        ar[i] -= br[i];
+        ai[i] -= bi[i];
+    }
+}
+
+static void multiplyScalar(double* ar, double* ai, const double* br, const double* bi, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        const double newReal = ar[i] * br[i] - ai[i] * bi[i];
+        const double newImag = ar[i] * bi[i] + ai[i] * br[i];
+        ar[i] = newReal;
+        ai[i] = newImag;
+    }
+}
+
+// the divisors are checked for zero before any kernel runs
+static void divideScalar(double* ar, double* ai, const double* br, const double* bi, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        Complex quotient(ar[i], ai[i]);
+        quotient /= Complex(br[i], bi[i]);
+        ar[i] = quotient.getReal();
+        ai[i] = quotient.getImag();
+    }
+}
+
+static void negateScalar(double* values, size_t n) {
+    for (size_t i = 0; i < n; ++i) values[i] = -values[i];
+}
+
+static void amplitudeScalar(const double* re, const double* im, double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = std::hypot(re[i], im[i]);
+}
+
+static const ComplexKernels SCALAR_KERNELS = {addScalar,    subtractScalar, multiplyScalar,
+                                              divideScalar, negateScalar,   amplitudeScalar};
+
+#ifdef COMPLEX_ARRAY_X86_SIMD
+
+//  AVX2 kernels, 4 doubles per register
+__attribute__((target("avx2,fma"))) static void addAvx2(double* ar, double* ai, const double* br, const double* bi,
+                                                        size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(ar + i, _mm256_add_pd(_mm256_loadu_pd(ar + i), _mm256_loadu_pd(br + i)));
+        _mm256_storeu_pd(ai + i, _mm256_add_pd(_mm256_loadu_pd(ai + i), _mm256_loadu_pd(bi + i)));
+    }
+    addScalar(ar + i, ai + i, br + i, bi + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) static void subtractAvx2(double* ar, double* ai, const double* br,
+                                                             const double* bi, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(ar + i, _mm256_sub_pd(_mm256_loadu_pd(ar + i), _mm256_loadu_pd(br + i)));
+        _mm256_storeu_pd(ai + i, _mm256_sub_pd(_mm256_loadu_pd(ai + i), _mm256_loadu_pd(bi + i)));
+    }
+    subtractScalar(ar + i, ai + i, br + i, bi + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) static void multiplyAvx2(double* ar, double* ai, const double* br,
+                                                             const double* bi, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d xr = _mm256_loadu_pd(ar + i), xi = _mm256_loadu_pd(ai + i);
+        const __m256d yr = _mm256_loadu_pd(br + i), yi = _mm256_loadu_pd(bi + i);
+        _mm256_storeu_pd(ar + i, _mm256_fmsub_pd(xr, yr, _mm256_mul_pd(xi, yi)));
+        _mm256_storeu_pd(ai + i, _mm256_fmadd_pd(xr, yi, _mm256_mul_pd(xi, yr)));
+    }
+    multiplyScalar(ar + i, ai + i, br + i, bi + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) static void divideAvx2(double* ar, double* ai, const double* br,
+                                                           const double* bi, size_t n) {
+    const __m256d signBit = _mm256_set1_pd(-0.0), one = _mm256_set1_pd(1.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d xr = _mm256_loadu_pd(ar + i), xi = _mm256_loadu_pd(ai + i);
+        const __m256d yr = _mm256_loadu_pd(br + i), yi = _mm256_loadu_pd(bi + i);
+        // Smith's algorithm with the two cases blended: big/small are the divisor parts by magnitude and
+        // the dividend parts are swapped to match; the imaginary part changes sign when the swap happens
+        const __m256d absReal = _mm256_andnot_pd(signBit, yr), absImag = _mm256_andnot_pd(signBit, yi);
+        const __m256d realBig = _mm256_cmp_pd(absReal, absImag, _CMP_GE_OQ);
+        const __m256d big = _mm256_blendv_pd(yi, yr, realBig), small = _mm256_blendv_pd(yr, yi, realBig);
+        const __m256d p = _mm256_blendv_pd(xi, xr, realBig), q = _mm256_blendv_pd(xr, xi, realBig);
+        const __m256d ratio = _mm256_div_pd(small, big);
+        const __m256d scale = _mm256_div_pd(one, _mm256_fmadd_pd(small, ratio, big));
+        const __m256d imag = _mm256_mul_pd(_mm256_fnmadd_pd(p, ratio, q), scale);
+        _mm256_storeu_pd(ar + i, _mm256_mul_pd(_mm256_fmadd_pd(q, ratio, p), scale));
+        _mm256_storeu_pd(ai + i, _mm256_xor_pd(imag, _mm256_andnot_pd(realBig, signBit)));
+    }
+    divideScalar(ar + i, ai + i, br + i, bi + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) static void negateAvx2(double* values, size_t n) {
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(values + i, _mm256_xor_pd(_mm256_loadu_pd(values + i), signBit));
+    }
+    negateScalar(values + i, n - i);
+}
+
+// hypot without overflow: max * sqrt(1 + (min / max)^2), with max == 0 handled separately. max/min drop a NaN
+// operand, so the special values are blended in afterwards, as std::hypot orders them: an infinite part gives
+// +inf even next to a NaN, otherwise any NaN part gives NaN.
+__attribute__((target("avx2,fma"))) static void amplitudeAvx2(const double* re, const double* im, double* out,
+                                                              size_t n) {
+    const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFF));
+    const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+    const __m256d infinity = _mm256_set1_pd(HUGE_VAL), notANumber = _mm256_set1_pd(NAN);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d x = _mm256_and_pd(_mm256_loadu_pd(re + i), absMask);
+        const __m256d y = _mm256_and_pd(_mm256_loadu_pd(im + i), absMask);
+        const __m256d isInf = _mm256_or_pd(_mm256_cmp_pd(x, infinity, _CMP_EQ_OQ),
+                                           _mm256_cmp_pd(y, infinity, _CMP_EQ_OQ));
+        const __m256d isNan = _mm256_cmp_pd(x, y, _CMP_UNORD_Q);
+        const __m256d big = _mm256_max_pd(x, y), small = _mm256_min_pd(x, y);
+        const __m256d ratio = _mm256_div_pd(small, big);
+        __m256d result = _mm256_mul_pd(big, _mm256_sqrt_pd(_mm256_fmadd_pd(ratio, ratio, one)));
+        result = _mm256_blendv_pd(result, zero, _mm256_cmp_pd(big, zero, _CMP_EQ_OQ));
+        result = _mm256_blendv_pd(result, notANumber, isNan);
+        result = _mm256_blendv_pd(result, infinity, isInf);
+        _mm256_storeu_pd(out + i, result);
+    }
+    amplitudeScalar(re + i, im + i, out + i, n - i);
+}
+
+static const ComplexKernels AVX2_KERNELS = {addAvx2, subtractAvx2, multiplyAvx2,
+                                            divideAvx2, negateAvx2, amplitudeAvx2};
+
+//  AVX-512 kernels, 8 doubles per register
+// GCC 12 reports the _mm512_undefined_pd() inside _mm512_sqrt/min/max_pd as maybe-uninitialized when optimizing
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+__attribute__((target("avx512f"))) static void addAvx512(double* ar, double* ai, const double* br, const double* bi,
+                                                         size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(ar + i, _mm512_add_pd(_mm512_loadu_pd(ar + i), _mm512_loadu_pd(br + i)));
+        _mm512_storeu_pd(ai + i, _mm512_add_pd(_mm512_loadu_pd(ai + i), _mm512_loadu_pd(bi + i)));
+    }
+    addScalar(ar + i, ai + i, br + i, bi + i, n - i);
+}
+
+__attribute__((target("avx512f"))) static void subtractAvx512(double* ar, double* ai, const double* br,
+                                                              const double* bi, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(ar + i, _mm512_sub_pd(_mm512_loadu_pd(ar + i), _mm512_loadu_pd(br + i)));
+        _mm512_storeu_pd(ai + i, _mm512_sub_pd(_mm512_loadu_pd(ai + i), _mm512_loadu_pd(bi + i)));
+    }
+    subtractScalar(ar + i, ai + i, br + i, bi + i, n - i);
+}
+
+__attribute__((target("avx512f"))) static void multiplyAvx512(double* ar, double* ai, const double* br,
+                                                              const double* bi, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d xr = _mm512_loadu_pd(ar + i), xi = _mm512_loadu_pd(ai + i);
+        const __m512d yr = _mm512_loadu_pd(br + i), yi = _mm512_loadu_pd(bi + i);
+        _mm512_storeu_pd(ar + i, _mm512_fmsub_pd(xr, yr, _mm512_mul_pd(xi, yi)));
+        _mm512_storeu_pd(ai + i, _mm512_fmadd_pd(xr, yi, _mm512_mul_pd(xi, yr)));
+    }
+    multiplyScalar(ar + i, ai + i, br + i, bi + i, n - i);
+}
+
+__attribute__((target("avx512f"))) static void divideAvx512(double* ar, double* ai, const double* br,
+                                                            const double* bi, size_t n) {
+    const __m512d one = _mm512_set1_pd(1.0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d xr = _mm512_loadu_pd(ar + i), xi = _mm512_loadu_pd(ai + i);
+        const __m512d yr = _mm512_loadu_pd(br + i), yi = _mm512_loadu_pd(bi + i);
+        // Smith's algorithm, blended as in divideAvx2
+        const __mmask8 realBig = _mm512_cmp_pd_mask(_mm512_abs_pd(yr), _mm512_abs_pd(yi), _CMP_GE_OQ);
+        const __m512d big = _mm512_mask_blend_pd(realBig, yi, yr), small = _mm512_mask_blend_pd(realBig, yr, yi);
+        const __m512d p = _mm512_mask_blend_pd(realBig, xi, xr), q = _mm512_mask_blend_pd(realBig, xr, xi);
+        const __m512d ratio = _mm512_div_pd(small, big);
+        const __m512d scale = _mm512_div_pd(one, _mm512_fmadd_pd(small, ratio, big));
+        const __m512d imag = _mm512_mul_pd(_mm512_fnmadd_pd(p, ratio, q), scale);
+        _mm512_storeu_pd(ar + i, _mm512_mul_pd(_mm512_fmadd_pd(q, ratio, p), scale));
+        _mm512_storeu_pd(ai + i, _mm512_mask_sub_pd(imag, static_cast<__mmask8>(~realBig), _mm512_setzero_pd(), imag));
+    }
+    divideScalar(ar + i, ai + i, br + i, bi + i, n - i);
+}
+
+__attribute__((target("avx512f"))) static void negateAvx512(double* values, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(values + i, _mm512_sub_pd(_mm512_setzero_pd(), _mm512_loadu_pd(values + i)));
+    }
+    negateScalar(values + i, n - i);
+}
+
+__attribute__((target("avx512f"))) static void amplitudeAvx512(const double* re, const double* im, double* out,
+                                                               size_t n) {
+    const __m512d zero = _mm512_setzero_pd(), one = _mm512_set1_pd(1.0);
+    const __m512d infinity = _mm512_set1_pd(HUGE_VAL), notANumber = _mm512_set1_pd(NAN);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d x = _mm512_abs_pd(_mm512_loadu_pd(re + i));
+        const __m512d y = _mm512_abs_pd(_mm512_loadu_pd(im + i));
+        // special values as in amplitudeAvx2
+        const __mmask8 isInf =
+            _mm512_cmp_pd_mask(x, infinity, _CMP_EQ_OQ) | _mm512_cmp_pd_mask(y, infinity, _CMP_EQ_OQ);
+        const __mmask8 isNan = _mm512_cmp_pd_mask(x, y, _CMP_UNORD_Q);
+        const __m512d big = _mm512_max_pd(x, y), small = _mm512_min_pd(x, y);
+        const __m512d ratio = _mm512_div_pd(small, big);
+        __m512d result = _mm512_mul_pd(big, _mm512_sqrt_pd(_mm512_fmadd_pd(ratio, ratio, one)));
+        result = _mm512_mask_mov_pd(result, _mm512_cmp_pd_mask(big, zero, _CMP_EQ_OQ), zero);
+        result = _mm512_mask_mov_pd(result, isNan, notANumber);
+        result = _mm512_mask_mov_pd(result, isInf, infinity);
+        _mm512_storeu_pd(out + i, result);
+    }
+    amplitudeScalar(re + i, im + i, out + i, n - i);
+}
+
+#pragma GCC diagnostic pop
+
+static const ComplexKernels AVX512_KERNELS = {addAvx512,    subtractAvx512, multiplyAvx512,
+                                              divideAvx512, negateAvx512,   amplitudeAvx512};
+
+static bool isSupported(ComplexArray::SimdBackend backend) {
+    switch (backend) {
+    case ComplexArray::SimdBackend::Avx512:
+        return __builtin_cpu_supports("avx512f");
+    case ComplexArray::SimdBackend::Avx2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    default:
+        return true;
+    }
+}
+
+static const ComplexKernels& kernelsFor(ComplexArray::SimdBackend backend) {
+    switch (backend) {
+    case ComplexArray::SimdBackend::Avx512:
+        return AVX512_KERNELS;
+    case ComplexArray::SimdBackend::Avx2:
+        return AVX2_KERNELS;
+    default:
+        return SCALAR_KERNELS;
+    }
+}
+
+#else
+
+static bool isSupported(ComplexArray::SimdBackend backend) { return backend == ComplexArray::SimdBackend::Scalar; }
+
+static const ComplexKernels& kernelsFor(ComplexArray::SimdBackend) { return SCALAR_KERNELS; }
+
+#endif
+
+static ComplexArray::SimdBackend bestBackendUpTo(ComplexArray::SimdBackend backend) {
+    using Backend = ComplexArray::SimdBackend;
+    if (backend == Backend::Avx512 && !isSupported(Backend::Avx512)) backend = Backend::Avx2;
+    if (backend == Backend::Avx2 && !isSupported(Backend::Avx2)) backend = Backend::Scalar;
+    return backend;
+}
+
+static ComplexArray::SimdBackend selectedBackend = bestBackendUpTo(ComplexArray::SimdBackend::Avx512);
+static const ComplexKernels* kernels = &kernelsFor(selectedBackend);
+
+ComplexArray::SimdBackend ComplexArray::activeBackend() { return selectedBackend; }
+
+ComplexArray::SimdBackend ComplexArray::forceBackend(SimdBackend backend) {
+    selectedBackend = bestBackendUpTo(backend);
+    kernels = &kernelsFor(selectedBackend);
+    return selectedBackend;
+}
+
+ComplexArray::ComplexArray(size_t size) : realParts(size, 0.0), imagParts(size, 0.0) {}
+
+ComplexArray::ComplexArray(const std::vector<Complex>& values) : realParts(values.size()), imagParts(values.size()) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        realParts[i] = values[i].getReal();
+        imagParts[i] = values[i].getImag();
+    }
+}
+
+std::vector<Complex> ComplexArray::toVector() const {
+    std::vector<Complex> values;
+    values.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        values.emplace_back(realParts[i], imagParts[i]);
+    }
+    return values;
+}
+
+void ComplexArray::resize(size_t size) {
+    realParts.resize(size, 0.0);
+    imagParts.resize(size, 0.0);
+}
+
+void ComplexArray::set(size_t index, const Complex& value) {
+    realParts[index] = value.getReal();
+    imagParts[index] = value.getImag();
+}
+
+void ComplexArray::throwIfSizeMismatch(const ComplexArray& other) const {
+    if (size() != other.size()) {
+        throw std::invalid_argument("Complex arrays must have the same size");
+    }
+}
+
+ComplexArray& ComplexArray::operator+=(const ComplexArray& other) {
+    throwIfSizeMismatch(other);
+    kernels->add(real(), imag(), other.real(), other.imag(), size());
+    return *this;
+}
+
+ComplexArray& ComplexArray::operator-=(const ComplexArray& other) {
+    throwIfSizeMismatch(other);
+    kernels->subtract(real(), imag(), other.real(), other.imag(), size());
+    return *this;
+}
+
+ComplexArray& ComplexArray::operator*=(const ComplexArray& other) {
+    throwIfSizeMismatch(other);
+    kernels->multiply(real(), imag(), other.real(), other.imag(), size());
+    return *this;
+}
+
+ComplexArray& ComplexArray::operator/=(const ComplexArray& other) {
+    throwIfSizeMismatch(other);
+    bool hasZero = false;
+    for (size_t i = 0; i < size(); ++i) {
+        hasZero |= other.realParts[i] == 0.0 && other.imagParts[i] == 0.0;
+    }
+    if (hasZero) {
+        throw std::runtime_error("Division by zero");
+    }
+    kernels->divide(real(), imag(), other.real(), other.imag(), size());
+    return *this;
+}
+
+ComplexArray& ComplexArray::conjugate() {
+    kernels->negate(imag(), size());
+    return *this;
+}
+
+void ComplexArray::amplitude(double* out) const { kernels->amplitude(real(), imag(), out, size()); }
+
+// phase(double*) is defined in ComplexMath.cpp, next to the atan2 kernel its vector loops are built from
+
+std::vector<double> ComplexArray::amplitude() const {
+    std::vector<double> out(size());
+    amplitude(out.data());
+    return out;
+}
+
+std::vector<double> ComplexArray::phase() const {
+    std::vector<double> out(size());
+    phase(out.data());
+    return out;
+}
+
+ComplexArray operator+(ComplexArray a1, const ComplexArray& a2) { return std::move(a1 += a2); }
+ComplexArray operator-(ComplexArray a1, const ComplexArray& a2) { return std::move(a1 -= a2); }
+ComplexArray operator*(ComplexArray a1, const ComplexArray& a2) { return std::move(a1 *= a2); }
+ComplexArray operator/(ComplexArray a1, const ComplexArray& a2) { return std::move(a1 /= a2); }
@@ -0,0 +1,568 @@
+#include "../include/ComplexMath.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// The batch functions are written as plain loops over the real and imaginary rows with no calls and no
+// branches, so the compiler can vectorize them. Each loop is compiled once per backend (see the wrappers
+// at the end), the same split ComplexArray uses for its arithmetic. Elements a kernel cannot handle are
+// stored as NaN and then recomputed with the scalar functions from ComplexMath.h.
+
+static inline uint64_t bitsOf(double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return bits;
+}
+
+static inline double fromBits(uint64_t bits) {
+    double x;
+    std::memcpy(&x, &bits, sizeof x);
+    return x;
+}
+
+// condition ? ifTrue : ifFalse on the bits. Written as a ternary, the compiler would move the arithmetic
+// producing the operands under a branch, and a branch in the loop body stops vectorization.
+static inline double select(bool condition, double ifTrue, double ifFalse) {
+    const uint64_t mask = uint64_t(0) - condition;
+    return fromBits((bitsOf(ifTrue) & mask) | (bitsOf(ifFalse) & ~mask));
+}
+
+static const double NOT_A_NUMBER = NAN;
+// adding 1.5 * 2^52 rounds to an integer and leaves it in the low mantissa bits
+static const double SHIFTER = 6755399441055744.0;
+static const uint64_t SIGN_BIT = uint64_t(1) << 63;
+
+// beyond these the polynomial kernels lose accuracy or the results leave the normal range
+static const double EXP_LIMIT = 708.0;
+static const double TRIG_LIMIT = 1e5;
+// exponents up to this size that are integers go through repeated squaring, as in the scalar pow
+static const double MAX_INTEGER_EXPONENT = 64.0;
+
+static const double PI = 3.14159265358979311600e+00;
+static const double PI_2 = 1.57079632679489655800e+00;
+static const double PI_4 = 7.85398163397448278999e-01;
+
+// e^x for |x| <= EXP_LIMIT: x = k*ln2 + r with |r| <= ln2/2, e^r from its Taylor series to r^13
+static inline double expKernel(double x) {
+    const double LOG2E = 1.44269504088896338700e+00;
+    const double LN2_HI = 6.93147180369123816490e-01; // leading 32 bits of ln2, so k * LN2_HI is exact
+    const double LN2_LO = 1.90821492927058770002e-10;
+
+    const double shifted = x * LOG2E + SHIFTER;
+    const double k = shifted - SHIFTER;
+    const double r = (x - k * LN2_HI) - k * LN2_LO;
+
+    double p = 1.0 / 6227020800.0;
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    // 2^k assembled directly in the exponent field
+    const uint64_t twoToK = (bitsOf(shifted) - bitsOf(SHIFTER) + 1023) << 52;
+    return p * fromBits(twoToK);
+}
+
+// sin and cos of y for |y| <= TRIG_LIMIT: y = k*pi/2 + r with |r| <= pi/4, Taylor series of sin r to r^15
+// and of cos r to r^16, then the quadrant k mod 4 picks and negates them
+static inline void sinCosKernel(double y, double& sinY, double& cosY) {
+    const double TWO_OVER_PI = 6.36619772367581382433e-01;
+    const double PIO2_1 = 1.57079632673412561417e+00; // pi/2 in three parts, the first two exact in 33 bits
+    const double PIO2_2 = 6.07710050630396597660e-11;
+    const double PIO2_3 = 2.02226624879595063154e-21;
+
+    const double shifted = y * TWO_OVER_PI + SHIFTER;
+    const double k = shifted - SHIFTER;
+    const double r = ((y - k * PIO2_1) - k * PIO2_2) - k * PIO2_3;
+    const double r2 = r * r;
+
+    double s = -1.0 / 1307674368000.0;
+    s = s * r2 + 1.0 / 6227020800.0;
+    s = s * r2 - 1.0 / 39916800.0;
+    s = s * r2 + 1.0 / 362880.0;
+    s = s * r2 - 1.0 / 5040.0;
+    s = s * r2 + 1.0 / 120.0;
+    s = s * r2 - 1.0 / 6.0;
+    s = r + r * r2 * s;
+
+    double c = 1.0 / 20922789888000.0;
+    c = c * r2 - 1.0 / 87178291200.0;
+    c = c * r2 + 1.0 / 479001600.0;
+    c = c * r2 - 1.0 / 3628800.0;
+    c = c * r2 + 1.0 / 40320.0;
+    c = c * r2 - 1.0 / 720.0;
+    c = c * r2 + 1.0 / 24.0;
+    c = c * r2 - 0.5;
+    c = 1.0 + r2 * c;
+
+    const uint64_t quadrant = bitsOf(shifted);
+    const bool swap = (quadrant & 1) != 0;
+    const uint64_t sinSign = (quadrant & 2) << 62;
+    const uint64_t cosSign = ((quadrant + 1) & 2) << 62;
+    sinY = fromBits(bitsOf(select(swap, c, s)) ^ sinSign);
+    cosY = fromBits(bitsOf(select(swap, s, c)) ^ cosSign);
+}
+
+// sinh and cosh of y for |y| <= EXP_LIMIT; small |y| takes the Taylor series of sinh to avoid cancellation
+static inline void sinhCoshKernel(double y, double& sinhY, double& coshY) {
+    const double e = expKernel(y), inverse = 1.0 / e;
+    const double y2 = y * y;
+    double series = 1.0 / 6227020800.0;
+    series = series * y2 + 1.0 / 39916800.0;
+    series = series * y2 + 1.0 / 362880.0;
+    series = series * y2 + 1.0 / 5040.0;
+    series = series * y2 + 1.0 / 120.0;
+    series = series * y2 + 1.0 / 6.0;
+    series = y + y * y2 * series;
+    sinhY = select(std::fabs(y) < 0.5, series, 0.5 * (e - inverse));
+    coshY = 0.5 * (e + inverse);
+}
+
+// 2 * atanh(s) for |s| < 0.172, from its series to s^21
+static inline double atanhSeries(double s) {
+    const double s2 = s * s;
+    double series = 1.0 / 21.0;
+    series = series * s2 + 1.0 / 19.0;
+    series = series * s2 + 1.0 / 17.0;
+    series = series * s2 + 1.0 / 15.0;
+    series = series * s2 + 1.0 / 13.0;
+    series = series * s2 + 1.0 / 11.0;
+    series = series * s2 + 1.0 / 9.0;
+    series = series * s2 + 1.0 / 7.0;
+    series = series * s2 + 1.0 / 5.0;
+    series = series * s2 + 1.0 / 3.0;
+    return 2.0 * s + 2.0 * s * s2 * series;
+}
+
+// log(u) for positive normal u: u = 2^e * m with m in [sqrt(1/2), sqrt(2)), and
+// log m = 2 * atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172
+static inline double logKernel(double u) {
+    const double LN2_HI = 6.93147180369123816490e-01;
+    const double LN2_LO = 1.90821492927058770002e-10;
+    const double SQRT2 = 1.41421356237309514547e+00;
+    const uint64_t MANTISSA = (uint64_t(1) << 52) - 1;
+
+    const uint64_t bits = bitsOf(u);
+    // the exponent field read as a double without an integer conversion
+    double e = fromBits((bits >> 52) | bitsOf(4503599627370496.0)) - 4503599627370496.0 - 1023.0;
+    double m = fromBits((bits & MANTISSA) | bitsOf(1.0));
+    const bool high = m > SQRT2;
+    m = select(high, 0.5 * m, m);
+    e = select(high, e + 1.0, e);
+
+    const double logM = atanhSeries((m - 1.0) / (m + 1.0));
+    return e * LN2_HI + (logM + e * LN2_LO);
+}
+
+// atan2(y, x) for (x, y) != (0, 0): atan of the ratio min/max in [0, 1], reduced below tan(pi/8) with
+// atan a = pi/4 + atan((a - 1) / (a + 1)), from its series to t^41; then moved to the right octant
+static inline double atan2Kernel(double y, double x) {
+    const double TAN_PI_8 = 4.14213562373095145475e-01;
+
+    const double ax = std::fabs(x), ay = std::fabs(y);
+    const double a = select(ax < ay, ax, ay) / select(ax < ay, ay, ax);
+    const bool reduce = a > TAN_PI_8;
+    const double t = select(reduce, (a - 1.0) / (a + 1.0), a);
+    const double t2 = t * t;
+
+    double series = 1.0 / 41.0;
+    series = series * t2 - 1.0 / 39.0;
+    series = series * t2 + 1.0 / 37.0;
+    series = series * t2 - 1.0 / 35.0;
+    series = series * t2 + 1.0 / 33.0;
+    series = series * t2 - 1.0 / 31.0;
+    series = series * t2 + 1.0 / 29.0;
+    series = series * t2 - 1.0 / 27.0;
+    series = series * t2 + 1.0 / 25.0;
+    series = series * t2 - 1.0 / 23.0;
+    series = series * t2 + 1.0 / 21.0;
+    series = series * t2 - 1.0 / 19.0;
+    series = series * t2 + 1.0 / 17.0;
+    series = series * t2 - 1.0 / 15.0;
+    series = series * t2 + 1.0 / 13.0;
+    series = series * t2 - 1.0 / 11.0;
+    series = series * t2 + 1.0 / 9.0;
+    series = series * t2 - 1.0 / 7.0;
+    series = series * t2 + 1.0 / 5.0;
+    series = series * t2 - 1.0 / 3.0;
+    double angle = select(reduce, PI_4, 0.0) + (t + t * t2 * series);
+
+    angle = select(ay > ax, PI_2 - angle, angle);
+    angle = select((bitsOf(x) & SIGN_BIT) != 0, PI - angle, angle);
+    return fromBits(bitsOf(angle) | (bitsOf(y) & SIGN_BIT));
+}
+
+// log|z| for normal, finite max(|x|, |y|): scaling both parts by the power of two below max(|x|, |y|)
+// keeps x^2 + y^2 in [1, 8) without overflow or underflow. Near |z| = 1 that sum would cancel against
+// e * ln2, so there, like the scalar log, it is log1p(t) / 2 with t = (x - 1)(x + 1) + y^2 and
+// log1p(t) = 2 * atanh(t / (2 + t)).
+static inline double logAmplitudeKernel(double x, double y) {
+    const double big = std::fabs(x) < std::fabs(y) ? std::fabs(y) : std::fabs(x);
+    const uint64_t exponentField = bitsOf(big) >> 52;
+    const double scale = fromBits((2046 - exponentField) << 52);
+    const double a = x * scale, b = y * scale;
+    const double e = fromBits(exponentField | bitsOf(4503599627370496.0)) - 4503599627370496.0 - 1023.0;
+    const double LN2 = 6.93147180559945286227e-01;
+
+    const double t = (x - 1.0) * (x + 1.0) + y * y;
+    const bool nearOne = (t > -0.25) & (t < 0.4);
+    return select(nearOne, 0.5 * atanhSeries(t / (2.0 + t)), e * LN2 + 0.5 * logKernel(a * a + b * b));
+}
+
+static inline bool logInRange(double x, double y) {
+    const double big = std::fabs(x) < std::fabs(y) ? std::fabs(y) : std::fabs(x);
+    return (big >= DBL_MIN) & (big <= DBL_MAX);
+}
+
+//  Batch loops, one output pair per input pair. Each returns whether any element was left as NaN.
+//  Range checks combine with & rather than &&, whose short circuit would be another branch, and the flag
+//  is gathered in a 64-bit integer: a bool reduction has no vector type of the loop's width.
+
+static inline __attribute__((always_inline)) bool expLoop(const double* re, const double* im, double* outRe,
+                                                          double* outIm, size_t n) {
+    uint64_t special = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const bool inRange = (std::fabs(re[i]) <= EXP_LIMIT) & (std::fabs(im[i]) <= TRIG_LIMIT);
+        const double magnitude = expKernel(re[i]);
+        double s, c;
+        sinCosKernel(im[i], s, c);
+        outRe[i] = select(inRange, magnitude * c, NOT_A_NUMBER);
+        outIm[i] = select(inRange, magnitude * s, NOT_A_NUMBER);
+        special |= uint64_t(!inRange);
+    }
+    return special != 0;
+}
+
+static inline __attribute__((always_inline)) bool logLoop(const double* re, const double* im, double* outRe,
+                                                          double* outIm, size_t n) {
+    uint64_t special = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const bool inRange = logInRange(re[i], im[i]);
+        const double logAmplitude = logAmplitudeKernel(re[i], im[i]);
+        const double phase = atan2Kernel(im[i], re[i]);
+        outRe[i] = select(inRange, logAmplitude, NOT_A_NUMBER);
+        outIm[i] = select(inRange, phase, NOT_A_NUMBER);
+        special |= uint64_t(!inRange);
+    }
+    return special != 0;
+}
+
+// root = sqrt((|x| + |z|) / 2), then sqrt(z) = (root, y / 2root) for x >= 0 and (|y| / 2root, +-root) otherwise
+static inline __attribute__((always_inline)) bool sqrtLoop(const double* re, const double* im, double* outRe,
+                                                           double* outIm, size_t n) {
+    uint64_t special = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const double x = re[i], y = im[i];
+        const double ax = std::fabs(x), ay = std::fabs(y);
+        const double big = ax < ay ? ay : ax, small = ax < ay ? ax : ay;
+        const bool inRange = (big >= 1e-300) & (big <= 1e300);
+        const double ratio = small / big;
+        const double root = std::sqrt(0.5 * (ax + big * std::sqrt(1.0 + ratio * ratio)));
+        const double other = 0.5 * ay / root;
+        const bool negative = (bitsOf(x) & SIGN_BIT) != 0;
+        const double first = select(negative, other, root);
+        const double second = fromBits(bitsOf(select(negative, root, other)) | (bitsOf(y) & SIGN_BIT));
+        outRe[i] = select(inRange, first, NOT_A_NUMBER);
+        outIm[i] = select(inRange, second, NOT_A_NUMBER);
+        special |= uint64_t(!inRange);
+    }
+    return special != 0;
+}
+
+// sin(x + iy) = (sin x cosh y, cos x sinh y), cos(x + iy) = (cos x cosh y, -sin x sinh y)
+static inline __attribute__((always_inline)) bool sinLoop(const double* re, const double* im, double* outRe,
+                                                          double* outIm, size_t n) {
+    uint64_t special = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const bool inRange = (std::fabs(re[i]) <= TRIG_LIMIT) & (std::fabs(im[i]) <= EXP_LIMIT);
+        double s, c, sh, ch;
+        sinCosKernel(re[i], s, c);
+        sinhCoshKernel(im[i], sh, ch);
+        outRe[i] = select(inRange, s * ch, NOT_A_NUMBER);
+        outIm[i] = select(inRange, c * sh, NOT_A_NUMBER);
+        special |= uint64_t(!inRange);
+    }
+    return special != 0;
+}
+
+static inline __attribute__((always_inline)) bool cosLoop(const double* re, const double* im, double* outRe,
+                                                          double* outIm, size_t n) {
+    uint64_t special = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const bool inRange = (std::fabs(re[i]) <= TRIG_LIMIT) & (std::fabs(im[i]) <= EXP_LIMIT);
+        double s, c, sh, ch;
+        sinCosKernel(re[i], s, c);
+        sinhCoshKernel(im[i], sh, ch);
+        outRe[i] = select(inRange, c * ch, NOT_A_NUMBER);
+        outIm[i] = select(inRange, -(s * sh), NOT_A_NUMBER);
+        special |= uint64_t(!inRange);
+    }
+    return special != 0;
+}
+
+// z^w = exp(w * log z); the exponent arrays wRe/wIm are read with stride wStride, 0 for a single exponent
+static inline __attribute__((always_inline)) bool powLoop(const double* re, const double* im, const double* wRe,
+                                                          const double* wIm, size_t wStride, double* outRe,
+                                                          double* outIm, size_t n) {
+    uint64_t special = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const double logAmplitude = logAmplitudeKernel(re[i], im[i]);
+        const double phase = atan2Kernel(im[i], re[i]);
+        const double a = wRe[i * wStride], b = wIm[i * wStride];
+        const double x = a * logAmplitude - b * phase, y = a * phase + b * logAmplitude;
+        // small integer exponents take the scalar function's repeated squaring, see integerPowLoop
+        const double clamped = select(std::fabs(a) <= MAX_INTEGER_EXPONENT, a, 0.5);
+        const bool integerExponent = (b == 0.0) & (clamped == static_cast<double>(static_cast<int>(clamped)));
+        const bool inRange = logInRange(re[i], im[i]) & (std::fabs(x) <= EXP_LIMIT) &
+                             (std::fabs(y) <= TRIG_LIMIT) & !integerExponent;
+        const double magnitude = expKernel(x);
+        double s, c;
+        sinCosKernel(y, s, c);
+        outRe[i] = select(inRange, magnitude * c, NOT_A_NUMBER);
+        outIm[i] = select(inRange, magnitude * s, NOT_A_NUMBER);
+        special |= uint64_t(!inRange);
+    }
+    return special != 0;
+}
+
+// z^n for 0 < n <= MAX_INTEGER_EXPONENT by repeated squaring: the products scalar pow computes, in the same
+// order, run over a block of elements at a time. Contracting them into fused multiply-adds would round
+// differently from the scalar function, and squaring doubles such differences at every step.
+#define NO_FP_CONTRACT __attribute__((optimize("fp-contract=off")))
+static inline __attribute__((always_inline)) NO_FP_CONTRACT void integerPowLoop(const double* re, const double* im,
+                                                                                unsigned n, double* outRe,
+                                                                                double* outIm, size_t count) {
+    constexpr size_t BLOCK = 256;
+    double baseRe[BLOCK], baseIm[BLOCK];
+    for (size_t start = 0; start < count; start += BLOCK) {
+        const size_t m = std::min(BLOCK, count - start);
+        double* const resultRe = outRe + start;
+        double* const resultIm = outIm + start;
+        for (size_t i = 0; i < m; ++i) {
+            baseRe[i] = re[start + i];
+            baseIm[i] = im[start + i];
+            resultRe[i] = 1.0;
+            resultIm[i] = 0.0;
+        }
+        for (unsigned k = n; k > 0; k >>= 1) {
+            if (k & 1) {
+                for (size_t i = 0; i < m; ++i) {
+                    const Complex product = Complex(resultRe[i], resultIm[i]) * Complex(baseRe[i], baseIm[i]);
+                    resultRe[i] = product.getReal();
+                    resultIm[i] = product.getImag();
+                }
+            }
+            for (size_t i = 0; i < m; ++i) {
+                const Complex square = Complex(baseRe[i], baseIm[i]) * Complex(baseRe[i], baseIm[i]);
+                baseRe[i] = square.getReal();
+                baseIm[i] = square.getImag();
+            }
+        }
+    }
+}
+
+// angle of (re, im) for both conversions to polar form
+static inline __attribute__((always_inline)) bool phaseLoop(const double* re, const double* im, double* out,
+                                                            size_t n) {
+    uint64_t special = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const bool inRange = logInRange(re[i], im[i]);
+        out[i] = select(inRange, atan2Kernel(im[i], re[i]), NOT_A_NUMBER);
+        special |= uint64_t(!inRange);
+    }
+    return special != 0;
+}
+
+// magnitude * (cos angle, sin angle)
+static inline __attribute__((always_inline)) bool fromPolarLoop(const double* magnitude, const double* angle,
+                                                                double* outRe, double* outIm, size_t n) {
+    uint64_t special = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const bool inRange = (std::fabs(angle[i]) <= TRIG_LIMIT) & (std::fabs(magnitude[i]) <= DBL_MAX);
+        double s, c;
+        sinCosKernel(angle[i], s, c);
+        outRe[i] = select(inRange, magnitude[i] * c, NOT_A_NUMBER);
+        outIm[i] = select(inRange, magnitude[i] * s, NOT_A_NUMBER);
+        special |= uint64_t(!inRange);
+    }
+    return special != 0;
+}
+
+using UnaryLoop = bool (*)(const double*, const double*, double*, double*, size_t);
+using PhaseLoop = bool (*)(const double*, const double*, double*, size_t);
+using PowLoop = bool (*)(const double*, const double*, const double*, const double*, size_t, double*, double*,
+                         size_t);
+using IntegerPowLoop = void (*)(const double*, const double*, unsigned, double*, double*, size_t);
+
+struct MathKernels {
+    UnaryLoop exp, log, sqrt, sin, cos, fromPolar;
+    PowLoop pow;
+    PhaseLoop phase;
+    IntegerPowLoop integerPow;
+};
+
+// Instantiates every loop for one backend. The loops inline into the wrappers and get vectorized for the
+// wrapper's target.
+#define COMPLEX_MATH_KERNELS(SUFFIX, ATTRIBUTES)                                                                  \
+    ATTRIBUTES static bool exp##SUFFIX(const double* re, const double* im, double* outRe, double* outIm,          \
+                                       size_t n) {                                                                \
+        return expLoop(re, im, outRe, outIm, n);                                                                  \
+    }                                                                                                             \
+    ATTRIBUTES static bool log##SUFFIX(const double* re, const double* im, double* outRe, double* outIm,          \
+                                       size_t n) {                                                                \
+        return logLoop(re, im, outRe, outIm, n);                                                                  \
+    }                                                                                                             \
+    ATTRIBUTES static bool sqrt##SUFFIX(const double* re, const double* im, double* outRe, double* outIm,         \
+                                        size_t n) {                                                               \
+        return sqrtLoop(re, im, outRe, outIm, n);                                                                 \
+    }                                                                                                             \
+    ATTRIBUTES static bool sin##SUFFIX(const double* re, const double* im, double* outRe, double* outIm,          \
+                                       size_t n) {                                                                \
+        return sinLoop(re, im, outRe, outIm, n);                                                                  \
+    }                                                                                                             \
+    ATTRIBUTES static bool cos##SUFFIX(const double* re, const double* im, double* outRe, double* outIm,          \
+                                       size_t n) {                                                                \
+        return cosLoop(re, im, outRe, outIm, n);                                                                  \
+    }                                                                                                             \
+    ATTRIBUTES static bool pow##SUFFIX(const double* re, const double* im, const double* wRe, const double* wIm,  \
+                                       size_t wStride, double* outRe, double* outIm, size_t n) {                  \
+        return powLoop(re, im, wRe, wIm, wStride, outRe, outIm, n);                                               \
+    }                                                                                                             \
+    ATTRIBUTES static bool fromPolar##SUFFIX(const double* magnitude, const double* angle, double* outRe,         \
+                                             double* outIm, size_t n) {                                           \
+        return fromPolarLoop(magnitude, angle, outRe, outIm, n);                                                  \
+    }                                                                                                             \
+    ATTRIBUTES static bool phase##SUFFIX(const double* re, const double* im, double* out, size_t n) {             \
+        return phaseLoop(re, im, out, n);                                                                         \
+    }                                                                                                             \
+    ATTRIBUTES NO_FP_CONTRACT static void integerPow##SUFFIX(const double* re, const double* im,                  \
+                                                             unsigned exponent, double* outRe, double* outIm,     \
+                                                             size_t n) {                                          \
+        integerPowLoop(re, im, exponent, outRe, outIm, n);                                                        \
+    }                                                                                                             \
+    static const MathKernels MATH_KERNELS##SUFFIX = {exp##SUFFIX, log##SUFFIX,       sqrt##SUFFIX, sin##SUFFIX,   \
+                                                     cos##SUFFIX, fromPolar##SUFFIX, pow##SUFFIX,  phase##SUFFIX, \
+                                                     integerPow##SUFFIX};
+
+COMPLEX_MATH_KERNELS(Scalar, )
+
+#if defined(__GNUC__) && defined(__x86_64__)
+COMPLEX_MATH_KERNELS(Avx2, __attribute__((target("avx2,fma"))))
+COMPLEX_MATH_KERNELS(Avx512, __attribute__((target("avx512f"))))
+#endif
+
+static const MathKernels& activeKernels() {
+#if defined(__GNUC__) && defined(__x86_64__)
+    switch (ComplexArray::activeBackend()) {
+    case ComplexArray::SimdBackend::Avx512:
+        return MATH_KERNELSAvx512;
+    case ComplexArray::SimdBackend::Avx2:
+        return MATH_KERNELSAvx2;
+    default:
+        break;
+    }
+#endif
+    return MATH_KERNELSScalar;
+}
+
+// Runs a loop over z and redoes the elements it left as NaN with the scalar function.
+template <typename Loop, typename Scalar>
+static ComplexArray apply(const ComplexArray& z, Loop loop, Scalar scalar) {
+    ComplexArray result(z.size());
+    if (loop(z.real(), z.imag(), result.real(), result.imag(), z.size())) {
+        for (size_t i = 0; i < z.size(); ++i) {
+            if (std::isnan(result.real()[i]) || std::isnan(result.imag()[i])) result.set(i, scalar(z[i]));
+        }
+    }
+    return result;
+}
+
+ComplexArray exp(const ComplexArray& z) {
+    return apply(z, activeKernels().exp, [](const Complex& c) { return exp(c); });
+}
+
+ComplexArray log(const ComplexArray& z) {
+    return apply(z, activeKernels().log, [](const Complex& c) { return log(c); });
+}
+
+ComplexArray sqrt(const ComplexArray& z) {
+    return apply(z, activeKernels().sqrt, [](const Complex& c) { return sqrt(c); });
+}
+
+ComplexArray sin(const ComplexArray& z) {
+    return apply(z, activeKernels().sin, [](const Complex& c) { return sin(c); });
+}
+
+ComplexArray cos(const ComplexArray& z) {
+    return apply(z, activeKernels().cos, [](const Complex& c) { return cos(c); });
+}
+
+ComplexArray pow(const ComplexArray& z, const Complex& w) {
+    const double wRe = w.getReal(), wIm = w.getImag();
+    if (wIm == 0.0 && wRe != 0.0 && wRe == std::trunc(wRe) && std::fabs(wRe) <= MAX_INTEGER_EXPONENT) {
+        ComplexArray result(z.size());
+        activeKernels().integerPow(z.real(), z.imag(), static_cast<unsigned>(std::fabs(wRe)), result.real(),
+                                   result.imag(), z.size());
+        for (size_t i = 0; i < z.size(); ++i) {
+            // zero has its own rules, and negative powers are the reciprocal of the positive one
+            if (z.real()[i] == 0.0 && z.imag()[i] == 0.0)
+                result.set(i, pow(z[i], w));
+            else if (wRe < 0.0)
+                result.set(i, Complex(1.0) / result[i]);
+        }
+        return result;
+    }
+    auto loop = [&](const double* re, const double* im, double* outRe, double* outIm, size_t n) {
+        return activeKernels().pow(re, im, &wRe, &wIm, 0, outRe, outIm, n);
+    };
+    return apply(z, loop, [&](const Complex& c) { return pow(c, w); });
+}
+
+ComplexArray pow(const ComplexArray& z, const ComplexArray& w) {
+    if (z.size() != w.size()) {
+        throw std::invalid_argument("Complex arrays must have the same size");
+    }
+    ComplexArray result(z.size());
+    if (activeKernels().pow(z.real(), z.imag(), w.real(), w.imag(), 1, result.real(), result.imag(), z.size())) {
+        for (size_t i = 0; i < z.size(); ++i) {
+            if (std::isnan(result.real()[i]) || std::isnan(result.imag()[i])) result.set(i, pow(z[i], w[i]));
+        }
+    }
+    return result;
+}
+
+// zero, subnormal and non-finite parts are left to std::atan2, which knows their signed angles
+void ComplexArray::phase(double* out) const {
+    if (activeKernels().phase(real(), imag(), out, size())) {
+        for (size_t i = 0; i < size(); ++i) {
+            if (std::isnan(out[i])) out[i] = std::atan2(imagParts[i], realParts[i]);
+        }
+    }
+}
+
+void toPolar(const ComplexArray& z, double* magnitude, double* angle) {
+    z.amplitude(magnitude);
+    z.phase(angle);
+}
+
+ComplexArray fromPolar(const double* magnitude, const double* angle, size_t n) {
+    ComplexArray result(n);
+    if (activeKernels().fromPolar(magnitude, angle, result.real(), result.imag(), n)) {
+        for (size_t i = 0; i < n; ++i) {
+            if (std::isnan(result.real()[i]) || std::isnan(result.imag()[i]))
+                result.set(i, Complex(magnitude[i] * std::cos(angle[i]), magnitude[i] * std::sin(angle[i])));
+        }
+    }
+    return result;
+}
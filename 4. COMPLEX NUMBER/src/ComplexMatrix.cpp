@@ -0,0 +1,480 @@
+#include "../include/ComplexMatrix.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define COMPLEX_MATRIX_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// GEMM: C += A * B on split planes, blocked the usual way (Goto/BLIS). A KC x NC block of B and an
+// MC x KC block of A are packed into contiguous panels, NR columns and MR rows wide, sized for L3 and L2;
+// the micro-kernel then keeps an MR x NR tile of C in registers while it walks one panel of each.
+// Edge panels are padded with zeros, so the micro-kernels always compute full tiles.
+
+static const size_t KC = 256;
+static const size_t MC = 64; // a multiple of every MR
+static const size_t NC = 512; // a multiple of every NR
+
+using AlignedBuffer = std::vector<double, AlignedAllocator<double>>;
+
+namespace {
+struct GemmOperands {
+    const double* ar;
+    const double* ai;
+    const double* br;
+    const double* bi;
+    double* cr;
+    double* ci;
+    size_t m, n, k; // A is m x k, B is k x n, C is m x n, all row-major with no padding
+};
+} // namespace
+
+//  Micro-kernels. Each computes one MR x NR tile from kc steps of an A panel (MR values per step) and a
+//  B panel (NR values per step) and stores it row-major into re and im.
+//  4M: re = sum ar*br - ai*bi, im = sum ar*bi + ai*br.
+//  3M: t1 = sum ar*br, t2 = sum ai*bi, t3 = sum (ar + ai)*(br + bi); re = t1 - t2, im = t3 - t1 - t2,
+//  with as and bs the packed sums.
+
+struct ScalarGemm {
+    static const size_t MR = 4, NR = 4;
+
+    static void kernel4M(size_t kc, const double* ar, const double* ai, const double* br, const double* bi,
+                         double* re, double* im) {
+        double accRe[MR][NR] = {}, accIm[MR][NR] = {};
+        for (size_t p = 0; p < kc; ++p) {
+            for (size_t r = 0; r < MR; ++r) {
+                for (size_t c = 0; c < NR; ++c) {
+                    accRe[r][c] += ar[p * MR + r] * br[p * NR + c] - ai[p * MR + r] * bi[p * NR + c];
+                    accIm[r][c] += ar[p * MR + r] * bi[p * NR + c] + ai[p * MR + r] * br[p * NR + c];
+                }
+            }
+        }
+        std::copy_n(&accRe[0][0], MR * NR, re);
+        std::copy_n(&accIm[0][0], MR * NR, im);
+    }
+
+    static void kernel3M(size_t kc, const double* ar, const double* ai, const double* as, const double* br,
+                         const double* bi, const double* bs, double* re, double* im) {
+        double t1[MR][NR] = {}, t2[MR][NR] = {}, t3[MR][NR] = {};
+        for (size_t p = 0; p < kc; ++p) {
+            for (size_t r = 0; r < MR; ++r) {
+                for (size_t c = 0; c < NR; ++c) {
+                    t1[r][c] += ar[p * MR + r] * br[p * NR + c];
+                    t2[r][c] += ai[p * MR + r] * bi[p * NR + c];
+                    t3[r][c] += as[p * MR + r] * bs[p * NR + c];
+                }
+            }
+        }
+        for (size_t r = 0; r < MR; ++r) {
+            for (size_t c = 0; c < NR; ++c) {
+                re[r * NR + c] = t1[r][c] - t2[r][c];
+                im[r * NR + c] = t3[r][c] - t1[r][c] - t2[r][c];
+            }
+        }
+    }
+};
+
+#ifdef COMPLEX_MATRIX_X86_SIMD
+
+// one ymm column block, 4 x 4 tiles: 8 accumulators for 4M and 12 for 3M out of 16 registers
+struct Avx2Gemm {
+    static const size_t MR = 4, NR = 4;
+
+    __attribute__((target("avx2,fma"))) static void kernel4M(size_t kc, const double* ar, const double* ai,
+                                                             const double* br, const double* bi, double* re,
+                                                             double* im) {
+        __m256d accRe[MR], accIm[MR];
+        for (size_t r = 0; r < MR; ++r) accRe[r] = accIm[r] = _mm256_setzero_pd();
+        for (size_t p = 0; p < kc; ++p) {
+            const __m256d bRe = _mm256_load_pd(br + p * NR), bIm = _mm256_load_pd(bi + p * NR);
+            for (size_t r = 0; r < MR; ++r) {
+                const __m256d aRe = _mm256_broadcast_sd(ar + p * MR + r), aIm = _mm256_broadcast_sd(ai + p * MR + r);
+                accRe[r] = _mm256_fnmadd_pd(aIm, bIm, _mm256_fmadd_pd(aRe, bRe, accRe[r]));
+                accIm[r] = _mm256_fmadd_pd(aIm, bRe, _mm256_fmadd_pd(aRe, bIm, accIm[r]));
+            }
+        }
+        for (size_t r = 0; r < MR; ++r) {
+            _mm256_storeu_pd(re + r * NR, accRe[r]);
+            _mm256_storeu_pd(im + r * NR, accIm[r]);
+        }
+    }
+
+    __attribute__((target("avx2,fma"))) static void kernel3M(size_t kc, const double* ar, const double* ai,
+                                                             const double* as, const double* br, const double* bi,
+                                                             const double* bs, double* re, double* im) {
+        __m256d t1[MR], t2[MR], t3[MR];
+        for (size_t r = 0; r < MR; ++r) t1[r] = t2[r] = t3[r] = _mm256_setzero_pd();
+        for (size_t p = 0; p < kc; ++p) {
+            const __m256d bRe = _mm256_load_pd(br + p * NR), bIm = _mm256_load_pd(bi + p * NR);
+            const __m256d bSum = _mm256_load_pd(bs + p * NR);
+            for (size_t r = 0; r < MR; ++r) {
+                t1[r] = _mm256_fmadd_pd(_mm256_broadcast_sd(ar + p * MR + r), bRe, t1[r]);
+                t2[r] = _mm256_fmadd_pd(_mm256_broadcast_sd(ai + p * MR + r), bIm, t2[r]);
+                t3[r] = _mm256_fmadd_pd(_mm256_broadcast_sd(as + p * MR + r), bSum, t3[r]);
+            }
+        }
+        for (size_t r = 0; r < MR; ++r) {
+            _mm256_storeu_pd(re + r * NR, _mm256_sub_pd(t1[r], t2[r]));
+            _mm256_storeu_pd(im + r * NR, _mm256_sub_pd(_mm256_sub_pd(t3[r], t1[r]), t2[r]));
+        }
+    }
+};
+
+// one zmm column block, 8 x 8 tiles: 16 accumulators for 4M and 24 for 3M out of 32 registers
+struct Avx512Gemm {
+    static const size_t MR = 8, NR = 8;
+
+    __attribute__((target("avx512f"))) static void kernel4M(size_t kc, const double* ar, const double* ai,
+                                                            const double* br, const double* bi, double* re,
+                                                            double* im) {
+        __m512d accRe[MR], accIm[MR];
+        for (size_t r = 0; r < MR; ++r) accRe[r] = accIm[r] = _mm512_setzero_pd();
+        for (size_t p = 0; p < kc; ++p) {
+            const __m512d bRe = _mm512_load_pd(br + p * NR), bIm = _mm512_load_pd(bi + p * NR);
+            for (size_t r = 0; r < MR; ++r) {
+                const __m512d aRe = _mm512_set1_pd(ar[p * MR + r]), aIm = _mm512_set1_pd(ai[p * MR + r]);
+                accRe[r] = _mm512_fnmadd_pd(aIm, bIm, _mm512_fmadd_pd(aRe, bRe, accRe[r]));
+                accIm[r] = _mm512_fmadd_pd(aIm, bRe, _mm512_fmadd_pd(aRe, bIm, accIm[r]));
+            }
+        }
+        for (size_t r = 0; r < MR; ++r) {
+            _mm512_storeu_pd(re + r * NR, accRe[r]);
+            _mm512_storeu_pd(im + r * NR, accIm[r]);
+        }
+    }
+
+    __attribute__((target("avx512f"))) static void kernel3M(size_t kc, const double* ar, const double* ai,
+                                                            const double* as, const double* br, const double* bi,
+                                                            const double* bs, double* re, double* im) {
+        __m512d t1[MR], t2[MR], t3[MR];
+        for (size_t r = 0; r < MR; ++r) t1[r] = t2[r] = t3[r] = _mm512_setzero_pd();
+        for (size_t p = 0; p < kc; ++p) {
+            const __m512d bRe = _mm512_load_pd(br + p * NR), bIm = _mm512_load_pd(bi + p * NR);
+            const __m512d bSum = _mm512_load_pd(bs + p * NR);
+            for (size_t r = 0; r < MR; ++r) {
+                t1[r] = _mm512_fmadd_pd(_mm512_set1_pd(ar[p * MR + r]), bRe, t1[r]);
+                t2[r] = _mm512_fmadd_pd(_mm512_set1_pd(ai[p * MR + r]), bIm, t2[r]);
+                t3[r] = _mm512_fmadd_pd(_mm512_set1_pd(as[p * MR + r]), bSum, t3[r]);
+            }
+        }
+        for (size_t r = 0; r < MR; ++r) {
+            _mm512_storeu_pd(re + r * NR, _mm512_sub_pd(t1[r], t2[r]));
+            _mm512_storeu_pd(im + r * NR, _mm512_sub_pd(_mm512_sub_pd(t3[r], t1[r]), t2[r]));
+        }
+    }
+};
+
+#endif
+
+// rows [i0, i0 + mc) x columns [p0, p0 + kc) of A into MR-row panels: panel by panel, column by column.
+// With sum set, the third plane receives re + im for the 3M algorithm.
+template <size_t MR>
+static void packA(const GemmOperands& op, size_t i0, size_t mc, size_t p0, size_t kc, double* re, double* im,
+                  double* sum) {
+    for (size_t ir = 0; ir < mc; ir += MR) {
+        const size_t rows = std::min(MR, mc - ir);
+        double *panelRe = re + ir * kc, *panelIm = im + ir * kc;
+        for (size_t p = 0; p < kc; ++p) {
+            for (size_t r = 0; r < MR; ++r) {
+                const size_t source = (i0 + ir + r) * op.k + p0 + p;
+                panelRe[p * MR + r] = r < rows ? op.ar[source] : 0.0;
+                panelIm[p * MR + r] = r < rows ? op.ai[source] : 0.0;
+            }
+        }
+        if (sum) {
+            for (size_t i = 0; i < kc * MR; ++i) sum[ir * kc + i] = panelRe[i] + panelIm[i];
+        }
+    }
+}
+
+// rows [p0, p0 + kc) x columns [j0, j0 + nc) of B into NR-column panels: panel by panel, row by row
+template <size_t NR>
+static void packB(const GemmOperands& op, size_t p0, size_t kc, size_t j0, size_t nc, double* re, double* im,
+                  double* sum) {
+    for (size_t jr = 0; jr < nc; jr += NR) {
+        const size_t columns = std::min(NR, nc - jr);
+        double *panelRe = re + jr * kc, *panelIm = im + jr * kc;
+        for (size_t p = 0; p < kc; ++p) {
+            const size_t source = (p0 + p) * op.n + j0 + jr;
+            for (size_t c = 0; c < NR; ++c) {
+                panelRe[p * NR + c] = c < columns ? op.br[source + c] : 0.0;
+                panelIm[p * NR + c] = c < columns ? op.bi[source + c] : 0.0;
+            }
+        }
+        if (sum) {
+            for (size_t i = 0; i < kc * NR; ++i) sum[jr * kc + i] = panelRe[i] + panelIm[i];
+        }
+    }
+}
+
+template <typename Kernels>
+static void gemmLoop(const GemmOperands& op, bool threeM) {
+    const size_t MR = Kernels::MR, NR = Kernels::NR;
+    const size_t planes = threeM ? 3 : 2;
+    const size_t mcMax = std::min(MC, (op.m + MR - 1) / MR * MR);
+    const size_t kcMax = std::min(KC, op.k);
+    const size_t ncMax = std::min(NC, (op.n + NR - 1) / NR * NR);
+    const size_t aPlane = mcMax * kcMax, bPlane = kcMax * ncMax;
+    AlignedBuffer packedA(planes * aPlane), packedB(planes * bPlane);
+    double *aRe = packedA.data(), *aIm = aRe + aPlane, *aSum = threeM ? aIm + aPlane : nullptr;
+    double *bRe = packedB.data(), *bIm = bRe + bPlane, *bSum = threeM ? bIm + bPlane : nullptr;
+    double tileRe[MR * NR], tileIm[MR * NR];
+
+    for (size_t j0 = 0; j0 < op.n; j0 += NC) {
+        const size_t nc = std::min(NC, op.n - j0);
+        for (size_t p0 = 0; p0 < op.k; p0 += KC) {
+            const size_t kc = std::min(KC, op.k - p0);
+            packB<NR>(op, p0, kc, j0, nc, bRe, bIm, bSum);
+            for (size_t i0 = 0; i0 < op.m; i0 += MC) {
+                const size_t mc = std::min(MC, op.m - i0);
+                packA<MR>(op, i0, mc, p0, kc, aRe, aIm, aSum);
+                for (size_t jr = 0; jr < nc; jr += NR) {
+                    const size_t nr = std::min(NR, nc - jr);
+                    for (size_t ir = 0; ir < mc; ir += MR) {
+                        const size_t mr = std::min(MR, mc - ir);
+                        const size_t a = ir * kc, b = jr * kc;
+                        if (threeM)
+                            Kernels::kernel3M(kc, aRe + a, aIm + a, aSum + a, bRe + b, bIm + b, bSum + b, tileRe,
+                                              tileIm);
+                        else
+                            Kernels::kernel4M(kc, aRe + a, aIm + a, bRe + b, bIm + b, tileRe, tileIm);
+
+                        double* cr = op.cr + (i0 + ir) * op.n + j0 + jr;
+                        double* ci = op.ci + (i0 + ir) * op.n + j0 + jr;
+                        for (size_t r = 0; r < mr; ++r) {
+                            for (size_t c = 0; c < nr; ++c) {
+                                cr[r * op.n + c] += tileRe[r * NR + c];
+                                ci[r * op.n + c] += tileIm[r * NR + c];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void gemm(const GemmOperands& op, bool threeM) {
+#ifdef COMPLEX_MATRIX_X86_SIMD
+    switch (ComplexArray::activeBackend()) {
+    case ComplexArray::SimdBackend::Avx512:
+        return gemmLoop<Avx512Gemm>(op, threeM);
+    case ComplexArray::SimdBackend::Avx2:
+        return gemmLoop<Avx2Gemm>(op, threeM);
+    default:
+        break;
+    }
+#endif
+    gemmLoop<ScalarGemm>(op, threeM);
+}
+
+ComplexMatrix::MatrixData::MatrixData(size_t rows, size_t cols)
+    : rows(rows), cols(cols), realParts(rows * cols, 0.0), imagParts(rows * cols, 0.0), refCount(1) {
+    if (rows == 0 || cols == 0) {
+        throw std::invalid_argument("Matrix dimensions must be positive");
+    }
+}
+
+void ComplexMatrix::swapContents(ComplexMatrix& other) { std::swap(sharedData, other.sharedData); }
+
+ComplexMatrix::ComplexMatrix(size_t rows, size_t cols) {
+    if (rows == 0 && cols == 0) {
+        sharedData = nullptr;
+    }
+    else {
+        sharedData = new MatrixData(rows, cols);
+    }
+}
+
+ComplexMatrix::ComplexMatrix(size_t rows, size_t cols, const Complex& initValue)
+    : sharedData(new MatrixData(rows, cols)) {
+    std::fill(sharedData->realParts.begin(), sharedData->realParts.end(), initValue.getReal());
+    std::fill(sharedData->imagParts.begin(), sharedData->imagParts.end(), initValue.getImag());
+}
+
+ComplexMatrix::ComplexMatrix(size_t rows, size_t cols, const Complex* data) : sharedData(new MatrixData(rows, cols)) {
+    for (size_t i = 0; i < rows * cols; ++i) {
+        sharedData->realParts[i] = data[i].getReal();
+        sharedData->imagParts[i] = data[i].getImag();
+    }
+}
+
+ComplexMatrix::ComplexMatrix(const ComplexMatrix& other) : sharedData(other.sharedData) {
+    if (sharedData) {
+        sharedData->refCount++;
+    }
+}
+
+ComplexMatrix& ComplexMatrix::operator=(ComplexMatrix other) {
+    swapContents(other);
+    return *this;
+}
+
+ComplexMatrix::~ComplexMatrix() {
+    if (sharedData) {
+        sharedData->refCount--;
+        if (sharedData->refCount == 0) {
+            delete sharedData;
+        }
+    }
+}
+
+void ComplexMatrix::detachIfNotUniqueOwner() {
+    if (sharedData && sharedData->refCount > 1) {
+        MatrixData* newData = new MatrixData(*sharedData);
+        newData->refCount = 1;
+        sharedData->refCount--;
+        sharedData = newData;
+    }
+}
+
+void ComplexMatrix::validateIndex(size_t row, size_t col) const {
+    if (!sharedData || row >= sharedData->rows || col >= sharedData->cols) {
+        throw std::out_of_range("Matrix index out of bounds");
+    }
+}
+
+void ComplexMatrix::throwIfDimensionsMismatch(const ComplexMatrix& other, const char* operation) const {
+    if (getRows() != other.getRows() || getColumns() != other.getColumns()) {
+        throw std::invalid_argument(std::string("Matrix dimensions must match for ") + operation);
+    }
+}
+
+Complex ComplexMatrix::read(size_t row, size_t col) const {
+    validateIndex(row, col);
+    const size_t index = row * sharedData->cols + col;
+    return Complex(sharedData->realParts[index], sharedData->imagParts[index]);
+}
+
+void ComplexMatrix::write(size_t row, size_t col, const Complex& value) {
+    validateIndex(row, col);
+    detachIfNotUniqueOwner();
+    const size_t index = row * sharedData->cols + col;
+    sharedData->realParts[index] = value.getReal();
+    sharedData->imagParts[index] = value.getImag();
+}
+
+Complex ComplexMatrix::operator()(size_t row, size_t col) const { return read(row, col); }
+
+ComplexMatrix::Ref ComplexMatrix::operator()(size_t row, size_t col) { return Ref(*this, row, col); }
+
+ComplexMatrix& ComplexMatrix::operator+=(const ComplexMatrix& other) {
+    throwIfDimensionsMismatch(other, "addition");
+    if (!sharedData) return *this;
+    detachIfNotUniqueOwner();
+    const size_t size = sharedData->rows * sharedData->cols;
+    double *re = mutableReal(), *im = mutableImag();
+    for (size_t i = 0; i < size; ++i) {
+        re[i] += other.real()[i];
+        im[i] += other.imag()[i];
+    }
+    return *this;
+}
+
+ComplexMatrix& ComplexMatrix::operator-=(const ComplexMatrix& other) {
+    throwIfDimensionsMismatch(other, "subtraction");
+    if (!sharedData) return *this;
+    detachIfNotUniqueOwner();
+    const size_t size = sharedData->rows * sharedData->cols;
+    double *re = mutableReal(), *im = mutableImag();
+    for (size_t i = 0; i < size; ++i) {
+        re[i] -= other.real()[i];
+        im[i] -= other.imag()[i];
+    }
+    return *this;
+}
+
+ComplexMatrix& ComplexMatrix::operator*=(const ComplexMatrix& other) {
+    *this = multiply(*this, other);
+    return *this;
+}
+
+ComplexMatrix ComplexMatrix::multiply(const ComplexMatrix& a, const ComplexMatrix& b, Algorithm algorithm,
+                                      unsigned threads) {
+    if (!a.sharedData || !b.sharedData || a.getColumns() != b.getRows()) {
+        throw std::invalid_argument("Matrix dimensions incompatible for multiplication");
+    }
+    const size_t m = a.getRows(), n = b.getColumns(), k = a.getColumns();
+    ComplexMatrix result(m, n);
+    const GemmOperands op = {a.real(), a.imag(), b.real(), b.imag(), result.mutableReal(), result.mutableImag(),
+                             m, n, k};
+    const bool threeM = algorithm == Algorithm::ThreeM;
+
+    if (threads == 0) {
+        threads = m * n * k >= PARALLEL_THRESHOLD ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+    }
+    // split the rows of C into whole MC blocks, each thread packing its own panels
+    const size_t blocks = (m + MC - 1) / MC;
+    threads = static_cast<unsigned>(std::min<size_t>(threads, blocks));
+    if (threads <= 1) {
+        gemm(op, threeM);
+        return result;
+    }
+
+    std::vector<std::thread> workers;
+    const size_t rowsPerThread = (blocks + threads - 1) / threads * MC;
+    for (size_t begin = 0; begin < m; begin += rowsPerThread) {
+        GemmOperands part = op;
+        part.m = std::min(rowsPerThread, m - begin);
+        part.ar += begin * k;
+        part.ai += begin * k;
+        part.cr += begin * n;
+        part.ci += begin * n;
+        workers.emplace_back([part, threeM] { gemm(part, threeM); });
+    }
+    for (auto& worker : workers) worker.join();
+    return result;
+}
+
+bool ComplexMatrix::operator==(const ComplexMatrix& other) const {
+    if (getRows() != other.getRows() || getColumns() != other.getColumns()) return false;
+    if (sharedData == other.sharedData) return true;
+    return sharedData->realParts == other.sharedData->realParts &&
+           sharedData->imagParts == other.sharedData->imagParts;
+}
+
+bool ComplexMatrix::operator!=(const ComplexMatrix& other) const { return !(*this == other); }
+
+// copies in square tiles so both the reads and the writes stay within a few cache lines
+ComplexMatrix ComplexMatrix::transposed(bool conjugate) const {
+    if (!sharedData) return ComplexMatrix();
+    const size_t rows = getRows(), cols = getColumns();
+    const size_t TILE = 32;
+    ComplexMatrix result(cols, rows);
+    const double sign = conjugate ? -1.0 : 1.0;
+    double *re = result.mutableReal(), *im = result.mutableImag();
+    for (size_t i0 = 0; i0 < rows; i0 += TILE) {
+        for (size_t j0 = 0; j0 < cols; j0 += TILE) {
+            for (size_t i = i0; i < std::min(i0 + TILE, rows); ++i) {
+                for (size_t j = j0; j < std::min(j0 + TILE, cols); ++j) {
+                    re[j * rows + i] = real()[i * cols + j];
+                    im[j * rows + i] = sign * imag()[i * cols + j];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+ComplexMatrix ComplexMatrix::transpose() const { return transposed(false); }
+
+ComplexMatrix ComplexMatrix::conjugateTranspose() const { return transposed(true); }
+
+ComplexMatrix operator+(const ComplexMatrix& m1, const ComplexMatrix& m2) { return ComplexMatrix(m1) += m2; }
+ComplexMatrix operator-(const ComplexMatrix& m1, const ComplexMatrix& m2) { return ComplexMatrix(m1) -= m2; }
+ComplexMatrix operator*(const ComplexMatrix& m1, const ComplexMatrix& m2) { return ComplexMatrix::multiply(m1, m2); }
+
+std::ostream& operator<<(std::ostream& out, const ComplexMatrix& matrix) {
+    for (size_t i = 0; i < matrix.getRows(); ++i) {
+        for (size_t j = 0; j < matrix.getColumns(); ++j) {
+            out << matrix(i, j);
+            if (j < matrix.getColumns() - 1) out << ' ';
+        }
+        if (i < matrix.getRows() - 1) out << '\n';
+    }
+    return out;
+}
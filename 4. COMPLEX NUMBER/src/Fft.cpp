@@ -0,0 +1,316 @@
+#include "../include/Fft.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+// Plans by length, shared between threads. Entries live until clearCache().
+template <typename Plan>
+class PlanCache {
+public:
+    std::shared_ptr<const Plan> get(size_t size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& plan = plans[size];
+        if (!plan) plan = std::make_shared<const Plan>(size);
+        return plan;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        plans.clear();
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<size_t, std::shared_ptr<const Plan>> plans;
+};
+
+// exp(-2*pi*i*j/n), evaluated in long double so the table is correctly rounded to double
+static Complex unitRoot(size_t j, size_t n) {
+    const long double pi = 3.141592653589793238462643383279502884L;
+    const long double angle = -2.0L * pi * static_cast<long double>(j) / static_cast<long double>(n);
+    return Complex(static_cast<double>(std::cos(angle)), static_cast<double>(std::sin(angle)));
+}
+
+static PlanCache<FftPlan> complexPlans;
+
+FftPlan::FftPlan(size_t size) : n(size) {
+    if (size == 0) {
+        throw std::invalid_argument("FFT length must be positive");
+    }
+
+    // radix 4 first: it needs fewer multiplications per point than two radix 2 stages
+    size_t remaining = size;
+    for (size_t radix : {4, 2, 3, 5}) {
+        while (remaining % radix == 0) {
+            remaining /= radix;
+            stages.push_back({radix, remaining});
+        }
+    }
+    for (size_t radix = 7; remaining > 1; radix += 2) {
+        if (radix * radix > remaining) radix = remaining;
+        while (remaining % radix == 0) {
+            remaining /= radix;
+            stages.push_back({radix, remaining});
+        }
+    }
+    if (stages.empty()) stages.push_back({1, 1});
+
+    twiddles.reserve(size);
+    for (size_t j = 0; j < size; ++j) twiddles.push_back(unitRoot(j, size));
+}
+
+std::shared_ptr<const FftPlan> FftPlan::get(size_t size) { return complexPlans.get(size); }
+
+// Decimation in time: the radix-p stage splits the input into p interleaved sub-sequences, transforms each
+// into a contiguous block of out, then combines the blocks with butterflies.
+void FftPlan::transform(Complex* out, const Complex* in, size_t fstride, size_t stage) const {
+    const size_t radix = stages[stage].radix, length = stages[stage].length;
+    if (length == 1) {
+        for (size_t q = 0; q < radix; ++q) out[q] = in[q * fstride];
+    }
+    else {
+        for (size_t q = 0; q < radix; ++q) transform(out + q * length, in + q * fstride, fstride * radix, stage + 1);
+    }
+    butterfly(out, fstride, stage, 0, length);
+}
+
+// Only the first stage is split: its sub-transforms are independent, and so are its butterflies for
+// different positions u.
+void FftPlan::transformParallel(Complex* out, const Complex* in, unsigned threads) const {
+    const size_t radix = stages[0].radix, length = stages[0].length;
+    std::vector<std::thread> workers;
+
+    const unsigned subThreads = static_cast<unsigned>(std::min<size_t>(threads, radix));
+    for (unsigned t = 0; t < subThreads; ++t) {
+        workers.emplace_back([=] {
+            for (size_t q = t; q < radix; q += subThreads) transform(out + q * length, in + q, radix, 1);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+
+    const size_t chunk = (length + threads - 1) / threads;
+    for (size_t begin = 0; begin < length; begin += chunk) {
+        workers.emplace_back([=] { butterfly(out, 1, 0, begin, std::min(begin + chunk, length)); });
+    }
+    for (auto& worker : workers) worker.join();
+}
+
+// Combines radix blocks of the given length for positions u in [begin, end). The twiddle for
+// block q at position u is twiddles[q * u * fstride].
+void FftPlan::butterfly(Complex* out, size_t fstride, size_t stage, size_t begin, size_t end) const {
+    const size_t radix = stages[stage].radix, m = stages[stage].length;
+    const Complex* tw = twiddles.data();
+
+    switch (radix) {
+    case 1:
+        return;
+    case 2:
+        for (size_t u = begin; u < end; ++u) {
+            const Complex t = out[u + m] * tw[u * fstride];
+            out[u + m] = out[u] - t;
+            out[u] += t;
+        }
+        return;
+    case 3: {
+        const double sin3 = tw[fstride * m].getImag(); // -sin(2*pi/3)
+        for (size_t u = begin; u < end; ++u) {
+            const Complex s1 = out[u + m] * tw[u * fstride];
+            const Complex s2 = out[u + 2 * m] * tw[2 * u * fstride];
+            const Complex sum = s1 + s2;
+            const Complex difference = (s1 - s2) * sin3;
+            const Complex middle = out[u] - sum * 0.5;
+            out[u] += sum;
+            out[u + m] = Complex(middle.getReal() - difference.getImag(), middle.getImag() + difference.getReal());
+            out[u + 2 * m] =
+                Complex(middle.getReal() + difference.getImag(), middle.getImag() - difference.getReal());
+        }
+        return;
+    }
+    case 4:
+        for (size_t u = begin; u < end; ++u) {
+            const Complex s0 = out[u + m] * tw[u * fstride];
+            const Complex s1 = out[u + 2 * m] * tw[2 * u * fstride];
+            const Complex s2 = out[u + 3 * m] * tw[3 * u * fstride];
+            const Complex even = out[u] + s1, evenDifference = out[u] - s1;
+            const Complex odd = s0 + s2, oddDifference = s0 - s2;
+            out[u] = even + odd;
+            out[u + 2 * m] = even - odd;
+            // multiplying oddDifference by -i and +i
+            out[u + m] = Complex(evenDifference.getReal() + oddDifference.getImag(),
+                                 evenDifference.getImag() - oddDifference.getReal());
+            out[u + 3 * m] = Complex(evenDifference.getReal() - oddDifference.getImag(),
+                                     evenDifference.getImag() + oddDifference.getReal());
+        }
+        return;
+    case 5: {
+        const Complex ya = tw[fstride * m], yb = tw[2 * fstride * m]; // exp(-2*pi*i/5), exp(-4*pi*i/5)
+        for (size_t u = begin; u < end; ++u) {
+            const Complex s0 = out[u];
+            const Complex s1 = out[u + m] * tw[u * fstride];
+            const Complex s2 = out[u + 2 * m] * tw[2 * u * fstride];
+            const Complex s3 = out[u + 3 * m] * tw[3 * u * fstride];
+            const Complex s4 = out[u + 4 * m] * tw[4 * u * fstride];
+            const Complex s7 = s1 + s4, s10 = s1 - s4, s8 = s2 + s3, s9 = s2 - s3;
+
+            out[u] = s0 + s7 + s8;
+            const Complex s5 = s0 + s7 * ya.getReal() + s8 * yb.getReal();
+            const Complex s6(s10.getImag() * ya.getImag() + s9.getImag() * yb.getImag(),
+                             -s10.getReal() * ya.getImag() - s9.getReal() * yb.getImag());
+            out[u + m] = s5 - s6;
+            out[u + 4 * m] = s5 + s6;
+
+            const Complex s11 = s0 + s7 * yb.getReal() + s8 * ya.getReal();
+            const Complex s12(-s10.getImag() * yb.getImag() + s9.getImag() * ya.getImag(),
+                              s10.getReal() * yb.getImag() - s9.getReal() * ya.getImag());
+            out[u + 2 * m] = s11 + s12;
+            out[u + 3 * m] = s11 - s12;
+        }
+        return;
+    }
+    default: {
+        // direct DFT of the radix values at each position
+        std::vector<Complex> scratch(radix);
+        for (size_t u = begin; u < end; ++u) {
+            for (size_t q = 0; q < radix; ++q) scratch[q] = out[u + q * m] * tw[q * u * fstride % n];
+            for (size_t k = 0; k < radix; ++k) {
+                Complex sum = scratch[0];
+                size_t index = 0;
+                for (size_t q = 1; q < radix; ++q) {
+                    index = (index + k * m * fstride) % n;
+                    sum += scratch[q] * tw[index];
+                }
+                out[u + k * m] = sum;
+            }
+        }
+        return;
+    }
+    }
+}
+
+void FftPlan::forward(const Complex* in, Complex* out, unsigned threads) const {
+    if (in == out) {
+        const std::vector<Complex> copy(in, in + n);
+        forward(copy.data(), out, threads);
+        return;
+    }
+    if (threads == 0) {
+        threads = n >= PARALLEL_THRESHOLD ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+    }
+    if (threads > 1 && stages.size() > 1)
+        transformParallel(out, in, threads);
+    else
+        transform(out, in, 1, 0);
+}
+
+// inverse(x) = conj(forward(conj(x))) / n
+void FftPlan::inverse(const Complex* in, Complex* out, unsigned threads) const {
+    std::vector<Complex> conjugated(n);
+    for (size_t i = 0; i < n; ++i) conjugated[i] = in[i].conjugate();
+    forward(conjugated.data(), out, threads);
+    const double scale = 1.0 / static_cast<double>(n);
+    for (size_t i = 0; i < n; ++i) out[i] = out[i].conjugate() * scale;
+}
+
+std::vector<Complex> fft(const std::vector<Complex>& input) {
+    std::vector<Complex> output(input.size());
+    if (!input.empty()) FftPlan::get(input.size())->forward(input.data(), output.data());
+    return output;
+}
+
+std::vector<Complex> ifft(const std::vector<Complex>& input) {
+    std::vector<Complex> output(input.size());
+    if (!input.empty()) FftPlan::get(input.size())->inverse(input.data(), output.data());
+    return output;
+}
+
+ComplexArray fft(const ComplexArray& input) { return ComplexArray(fft(input.toVector())); }
+
+ComplexArray ifft(const ComplexArray& input) { return ComplexArray(ifft(input.toVector())); }
+
+// An even-length real signal x is transformed as the complex signal z[j] = x[2j] + i*x[2j+1] of half the
+// length. With Z = fft(z) and h = n/2, the spectra of the even and odd samples are
+//     E[k] = (Z[k] + conj(Z[h-k])) / 2,    O[k] = (Z[k] - conj(Z[h-k])) / 2i,
+// and X[k] = E[k] + exp(-2*pi*i*k/n) * O[k] for k <= h.
+class RealFftPlan {
+public:
+    explicit RealFftPlan(size_t size) : half(FftPlan::get(size / 2)) {
+        for (size_t k = 0; k <= size / 2; ++k) superTwiddles.push_back(unitRoot(k, size));
+    }
+
+    void forward(const double* in, Complex* out) const {
+        const size_t h = half->size();
+        std::vector<Complex> z(h);
+        for (size_t j = 0; j < h; ++j) z[j] = Complex(in[2 * j], in[2 * j + 1]);
+        half->forward(z.data(), z.data());
+
+        const Complex minusHalfI(0.0, -0.5);
+        for (size_t k = 0; k <= h; ++k) {
+            const Complex zk = z[k % h], zm = z[(h - k) % h].conjugate();
+            const Complex even = (zk + zm) * 0.5, odd = (zk - zm) * minusHalfI;
+            out[k] = even + superTwiddles[k] * odd;
+        }
+    }
+
+    // E[k] = (X[k] + conj(X[h-k])) / 2,  O[k] = (X[k] - conj(X[h-k])) / (2 * exp(-2*pi*i*k/n)),  Z = E + i*O
+    void inverse(const Complex* in, double* out) const {
+        const size_t h = half->size();
+        std::vector<Complex> z(h);
+        for (size_t k = 0; k < h; ++k) {
+            const Complex xk = in[k], xm = in[h - k].conjugate();
+            const Complex even = (xk + xm) * 0.5, odd = (xk - xm) * 0.5 * superTwiddles[k].conjugate();
+            z[k] = even + Complex(0.0, 1.0) * odd;
+        }
+        half->inverse(z.data(), z.data());
+        for (size_t j = 0; j < h; ++j) {
+            out[2 * j] = z[j].getReal();
+            out[2 * j + 1] = z[j].getImag();
+        }
+    }
+
+private:
+    std::shared_ptr<const FftPlan> half;
+    std::vector<Complex> superTwiddles; // exp(-2*pi*i*k/n) for k <= n/2
+};
+
+static PlanCache<RealFftPlan> realPlans;
+
+void FftPlan::clearCache() {
+    complexPlans.clear();
+    realPlans.clear();
+}
+
+std::vector<Complex> rfft(const std::vector<double>& input) {
+    const size_t size = input.size();
+    if (size == 0) return {};
+    if (size % 2 == 1) {
+        // odd lengths have no half-length trick, so they take the complex transform
+        std::vector<Complex> spectrum = fft(std::vector<Complex>(input.begin(), input.end()));
+        spectrum.resize(size / 2 + 1);
+        return spectrum;
+    }
+    std::vector<Complex> spectrum(size / 2 + 1);
+    realPlans.get(size)->forward(input.data(), spectrum.data());
+    return spectrum;
+}
+
+std::vector<double> irfft(const std::vector<Complex>& spectrum, size_t size) {
+    if (spectrum.size() != size / 2 + 1) {
+        throw std::invalid_argument("spectrum must hold size / 2 + 1 bins");
+    }
+    if (size == 0) return {};
+    std::vector<double> signal(size);
+    if (size % 2 == 1) {
+        // rebuild the redundant upper half from Hermitian symmetry
+        std::vector<Complex> full(size);
+        for (size_t k = 0; k < size; ++k) full[k] = k <= size / 2 ? spectrum[k] : spectrum[size - k].conjugate();
+        const std::vector<Complex> values = ifft(full);
+        for (size_t j = 0; j < size; ++j) signal[j] = values[j].getReal();
+        return signal;
+    }
+    realPlans.get(size)->inverse(spectrum.data(), signal.data());
+    return signal;
+}
@@ -0,0 +1,16 @@
+#include "../include/PolarComplex.h"
+#include <algorithm>
+#include <charconv>
+#include <ostream>
+
+std::string PolarComplex::toString() const {
+    // both fields are at most 2 + 309 + 3 characters in fixed notation
+    char buffer[640];
+    char* ptr = std::to_chars(buffer, buffer + sizeof(buffer), Magnitude, std::chars_format::fixed, 2).ptr;
+    ptr = std::copy_n("*exp(", 5, ptr);
+    ptr = std::to_chars(ptr, buffer + sizeof(buffer), Angle, std::chars_format::fixed, 2).ptr;
+    ptr = std::copy_n("i)", 2, ptr);
+    return std::string(buffer, ptr);
+}
+
+std::ostream& operator<<(std::ostream& out, const PolarComplex& p) { return out << p.toString(); }
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "../include/ComplexArray.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Backend = ComplexArray::SimdBackend;
+
+static std::vector<Complex> randomValues(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    std::vector<Complex> values;
+    for (size_t i = 0; i < n; ++i) values.emplace_back(dist(gen), dist(gen));
+    return values;
+}
+
+// the vector kernels use fused multiply-add, so results may differ from Complex in the last bits
+static void expectNear(const Complex& actual, const Complex& expected) {
+    const double tolerance = 1e-14 * (1.0 + expected.amplitude());
+    EXPECT_NEAR(actual.getReal(), expected.getReal(), tolerance);
+    EXPECT_NEAR(actual.getImag(), expected.getImag(), tolerance);
+}
+
+static std::string backendName(Backend backend) {
+    switch (backend) {
+    case Backend::Avx512:
+        return "Avx512";
+    case Backend::Avx2:
+        return "Avx2";
+    default:
+        return "Scalar";
+    }
+}
+
+// Every test runs once per backend; backends the CPU lacks fall back and are checked anyway.
+class ComplexArrayBackends : public ::testing::TestWithParam<Backend> {
+protected:
+    Backend previous = ComplexArray::activeBackend();
+
+    void SetUp() override { ComplexArray::forceBackend(GetParam()); }
+    void TearDown() override { ComplexArray::forceBackend(previous); }
+};
+
+INSTANTIATE_TEST_SUITE_P(ComplexArray, ComplexArrayBackends,
+                         ::testing::Values(Backend::Scalar, Backend::Avx2, Backend::Avx512),
+                         [](const ::testing::TestParamInfo<Backend>& info) { return backendName(info.param); });
+
+// sizes around the vector widths, so the scalar tails are covered too
+static const size_t SIZES[] = {0, 1, 3, 4, 7, 8, 9, 17, 100};
+
+TEST_P(ComplexArrayBackends, ArithmeticMatchesComplex) {
+    for (size_t n : SIZES) {
+        const auto a = randomValues(n, 1), b = randomValues(n, 2);
+        const ComplexArray x(a), y(b);
+        const auto sum = (x + y).toVector(), difference = (x - y).toVector();
+        const auto product = (x * y).toVector(), quotient = (x / y).toVector();
+        ASSERT_EQ(sum.size(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(sum[i], a[i] + b[i]);
+            EXPECT_EQ(difference[i], a[i] - b[i]);
+            expectNear(product[i], a[i] * b[i]);
+            expectNear(quotient[i], a[i] / b[i]);
+        }
+    }
+}
+
+TEST_P(ComplexArrayBackends, ConjugateAmplitudeAndPhase) {
+    for (size_t n : SIZES) {
+        const auto a = randomValues(n, 3);
+        ComplexArray x(a);
+        const auto amplitude = x.amplitude(), phase = x.phase();
+        x.conjugate();
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(x[i], a[i].conjugate());
+            EXPECT_NEAR(amplitude[i], a[i].amplitude(), 1e-15 * a[i].amplitude());
+            EXPECT_DOUBLE_EQ(phase[i], a[i].phase());
+        }
+    }
+}
+
+TEST_P(ComplexArrayBackends, AmplitudeEdgeCases) {
+    const double inf = std::numeric_limits<double>::infinity();
+    const std::vector<Complex> values = {{0.0, 0.0}, {-0.0, 0.0},  {3.0, 4.0},     {1e300, 1e300}, {1e-300, 1e-300},
+                                         {inf, 1.0}, {1.0, -inf},  {inf, inf},     {-5.0, 0.0},    {0.0, -2.0},
+                                         {1.0, 1.0}, {1e200, 1.0}, {1.0, 1e-200},  {-7.0, 24.0},   {0.5, 0.0},
+                                         {0.0, 0.0}};
+    const auto amplitude = ComplexArray(values).amplitude();
+    for (size_t i = 0; i < values.size(); ++i) {
+        const double expected = values[i].amplitude();
+        if (std::isinf(expected))
+            EXPECT_TRUE(std::isinf(amplitude[i])) << i;
+        else
+            EXPECT_NEAR(amplitude[i], expected, 1e-15 * expected) << i;
+    }
+}
+
+// NaN where the reference is NaN, the same infinity where it is infinite, and within 4 ulp otherwise
+static void expectSameValue(double actual, double expected, double re, double im) {
+    SCOPED_TRACE(::testing::Message() << "at (" << re << ", " << im << ")");
+    if (std::isnan(expected))
+        EXPECT_TRUE(std::isnan(actual)) << actual;
+    else if (std::isinf(expected))
+        EXPECT_EQ(actual, expected);
+    else
+        EXPECT_DOUBLE_EQ(actual, expected);
+}
+
+TEST_P(ComplexArrayBackends, SpecialValuesMatchHypotAndAtan2) {
+    const double inf = std::numeric_limits<double>::infinity(), nan = std::numeric_limits<double>::quiet_NaN();
+    const double subnormal = std::numeric_limits<double>::denorm_min(), max = std::numeric_limits<double>::max();
+    const double parts[] = {0.0, -0.0, inf, -inf, nan, subnormal, -3 * subnormal, 1e-310, 1.0, -2.5, max};
+    // every pair, so each special value meets the others in full vectors and in the scalar tails
+    std::vector<Complex> values;
+    for (double re : parts) {
+        for (double im : parts) values.emplace_back(re, im);
+    }
+    const ComplexArray x(values);
+    const auto amplitude = x.amplitude(), phase = x.phase();
+    for (size_t i = 0; i < values.size(); ++i) {
+        const double re = values[i].getReal(), im = values[i].getImag();
+        expectSameValue(amplitude[i], std::hypot(re, im), re, im);
+        expectSameValue(phase[i], std::atan2(im, re), re, im);
+    }
+}
+
+TEST_P(ComplexArrayBackends, DivisionByZeroThrows) {
+    ComplexArray x(randomValues(9, 4));
+    std::vector<Complex> divisors = randomValues(9, 5);
+    divisors[8] = Complex(0.0, 0.0);
+    EXPECT_THROW(x / ComplexArray(divisors), std::runtime_error);
+}
+
+TEST(ComplexArray, SizeMismatchThrows) {
+    ComplexArray x(4), y(5);
+    EXPECT_THROW(x += y, std::invalid_argument);
+    EXPECT_THROW(x * y, std::invalid_argument);
+}
+
+TEST(ComplexArray, ConversionRoundTrip) {
+    const auto values = randomValues(13, 6);
+    ComplexArray x(values);
+    EXPECT_EQ(x.size(), values.size());
+    EXPECT_EQ(x.toVector(), values);
+
+    x.set(2, Complex(1.0, -1.0));
+    EXPECT_EQ(x[2], Complex(1.0, -1.0));
+    EXPECT_DOUBLE_EQ(x.real()[2], 1.0);
+    EXPECT_DOUBLE_EQ(x.imag()[2], -1.0);
+
+    x.resize(20);
+    EXPECT_EQ(x[19], Complex(0.0, 0.0));
+}
+
+TEST(ComplexArray, BuffersAreAligned) {
+    ComplexArray x(37);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(x.real()) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(x.imag()) % 64, 0u);
+}
+
+TEST(ComplexArray, ForceBackendFallsBack) {
+    const Backend previous = ComplexArray::activeBackend();
+    EXPECT_EQ(ComplexArray::forceBackend(Backend::Scalar), Backend::Scalar);
+    EXPECT_EQ(ComplexArray::activeBackend(), Backend::Scalar);
+    const Backend best = ComplexArray::forceBackend(Backend::Avx512);
+    EXPECT_EQ(best, previous);
+    ComplexArray::forceBackend(previous);
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "../include/ComplexMath.h"
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Backend = ComplexArray::SimdBackend;
+
+static std::complex<double> toStd(const Complex& c) { return {c.getReal(), c.getImag()}; }
+
+static void expectPartNear(double actual, double expected, double tolerance) {
+    if (std::isnan(expected))
+        EXPECT_TRUE(std::isnan(actual)) << actual;
+    else if (std::isinf(expected))
+        EXPECT_EQ(actual, expected);
+    else
+        EXPECT_NEAR(actual, expected, tolerance);
+}
+
+// relative error of a few ulp, measured against the larger of |expected| and 1e-300;
+// infinite and NaN parts must match
+static void expectUlps(const Complex& actual, std::complex<double> expected, double ulps) {
+    const double scale = std::max(std::abs(expected), 1e-300);
+    const double tolerance = ulps * std::numeric_limits<double>::epsilon() * scale;
+    SCOPED_TRACE(::testing::Message() << "expected " << expected);
+    expectPartNear(actual.getReal(), expected.real(), tolerance);
+    expectPartNear(actual.getImag(), expected.imag(), tolerance);
+}
+
+static std::vector<Complex> randomValues(size_t n, double range, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-range, range);
+    std::vector<Complex> values;
+    for (size_t i = 0; i < n; ++i) values.emplace_back(dist(gen), dist(gen));
+    return values;
+}
+
+TEST(ComplexDivision, SmithAvoidsOverflow) {
+    const Complex big(1e300, 1e300);
+    expectUlps(big / big, {1.0, 0.0}, 2);
+    expectUlps(Complex(1.0, 1.0) / Complex(1e-300, 1e-300), {1e300, 0.0}, 2);
+    const std::complex<double> expected = std::complex<double>(3.0, 4.0) / std::complex<double>(1e200, -1e200);
+    expectUlps(Complex(3.0, 4.0) / Complex(1e200, -1e200), expected, 4);
+}
+
+TEST(ComplexDivision, TinyDivisorDoesNotThrow) {
+    EXPECT_NO_THROW(Complex(1.0) / Complex(1e-200, 0.0));
+    EXPECT_THROW(Complex(1.0) / Complex(0.0, -0.0), std::runtime_error);
+}
+
+TEST(ComplexDivision, MatchesStdComplex) {
+    const auto a = randomValues(200, 10.0, 1), b = randomValues(200, 10.0, 2);
+    for (size_t i = 0; i < a.size(); ++i) expectUlps(a[i] / b[i], toStd(a[i]) / toStd(b[i]), 4);
+}
+
+TEST(ComplexFunctions, MatchStdComplex) {
+    for (const auto& z : randomValues(200, 5.0, 3)) {
+        expectUlps(exp(z), std::exp(toStd(z)), 4);
+        expectUlps(log(z), std::log(toStd(z)), 4);
+        expectUlps(sqrt(z), std::sqrt(toStd(z)), 4);
+        expectUlps(sin(z), std::sin(toStd(z)), 4);
+        expectUlps(cos(z), std::cos(toStd(z)), 4);
+        expectUlps(pow(z, Complex(0.5, -1.5)), std::pow(toStd(z), std::complex<double>(0.5, -1.5)), 64);
+    }
+}
+
+TEST(ComplexFunctions, BranchCutsAndSpecialValues) {
+    EXPECT_EQ(sqrt(Complex(-4.0, 0.0)), Complex(0.0, 2.0));
+    EXPECT_EQ(sqrt(Complex(-4.0, -0.0)), Complex(0.0, -2.0));
+    EXPECT_EQ(log(Complex(-1.0, 0.0)), Complex(0.0, M_PI));
+    EXPECT_TRUE(std::isinf(log(Complex()).getReal()));
+    EXPECT_EQ(exp(Complex(0.0, M_PI)), Complex(-1.0, 0.0));
+    expectUlps(sqrt(Complex(1e308, 1e308)), std::sqrt(std::complex<double>(1e308, 1e308)), 4);
+    const double tiny = std::ldexp(1.0, -40);
+    expectUlps(log(Complex(1.0 + tiny, 0.0)), {std::log1p(tiny), 0.0}, 4);
+}
+
+TEST(ComplexFunctions, Pow) {
+    EXPECT_EQ(pow(Complex(1.0, 1.0), 2.0), Complex(0.0, 2.0));
+    EXPECT_EQ(pow(Complex(0.0, 2.0), -2.0), Complex(-0.25, 0.0));
+    EXPECT_EQ(pow(Complex(3.0, 4.0), 0.0), Complex(1.0));
+    EXPECT_EQ(pow(Complex(), Complex(2.0, 1.0)), Complex());
+    EXPECT_THROW(pow(Complex(), Complex(-1.0, 0.0)), std::domain_error);
+    expectUlps(pow(Complex(-1.0, 0.0), 0.5), {0.0, 1.0}, 4);
+}
+
+static std::string backendName(Backend backend) {
+    switch (backend) {
+    case Backend::Avx512:
+        return "Avx512";
+    case Backend::Avx2:
+        return "Avx2";
+    default:
+        return "Scalar";
+    }
+}
+
+// Batch functions against the scalar ones, once per backend.
+class ComplexMathBackends : public ::testing::TestWithParam<Backend> {
+protected:
+    Backend previous = ComplexArray::activeBackend();
+
+    void SetUp() override { ComplexArray::forceBackend(GetParam()); }
+    void TearDown() override { ComplexArray::forceBackend(previous); }
+};
+
+INSTANTIATE_TEST_SUITE_P(ComplexMath, ComplexMathBackends,
+                         ::testing::Values(Backend::Scalar, Backend::Avx2, Backend::Avx512),
+                         [](const ::testing::TestParamInfo<Backend>& info) { return backendName(info.param); });
+
+// moderate arguments, plus values the kernels hand over to the scalar functions
+static std::vector<Complex> batchInputs() {
+    auto values = randomValues(203, 20.0, 4);
+    const double inf = std::numeric_limits<double>::infinity();
+    values.insert(values.end(), {Complex(0.0, 0.0), Complex(-3.0, 0.0), Complex(-3.0, -0.0), Complex(1e-310, 2e-310),
+                                 Complex(1e306, -1e306), Complex(800.0, 1.0), Complex(1.0, 800.0), Complex(1e6, 1.0),
+                                 Complex(inf, 0.0), Complex(0.5, 1e-9), Complex(-1e-8, 3.0)});
+    return values;
+}
+
+TEST_P(ComplexMathBackends, UnaryFunctionsMatchScalar) {
+    const auto values = batchInputs();
+    const ComplexArray z(values);
+    const auto expResult = exp(z), sinResult = sin(z), cosResult = cos(z), sqrtResult = sqrt(z);
+    for (size_t i = 0; i < values.size(); ++i) {
+        SCOPED_TRACE("z = " + values[i].toString() + " at " + std::to_string(i));
+        expectUlps(expResult[i], toStd(exp(values[i])), 8);
+        expectUlps(sinResult[i], toStd(sin(values[i])), 8);
+        expectUlps(cosResult[i], toStd(cos(values[i])), 8);
+        expectUlps(sqrtResult[i], toStd(sqrt(values[i])), 4);
+    }
+}
+
+TEST_P(ComplexMathBackends, LogMatchesScalar) {
+    auto values = batchInputs();
+    // |z| close to 1, where log|z| cancels unless it is computed as log1p(|z|^2 - 1) / 2
+    values.insert(values.end(), {Complex(0.9996790013493578, -1.16e-9), Complex(0.6, 0.8), Complex(1.0, 1e-5)});
+    const auto result = log(ComplexArray(values));
+    for (size_t i = 0; i < values.size(); ++i) {
+        SCOPED_TRACE("z = " + values[i].toString() + " at " + std::to_string(i));
+        const Complex expected = log(values[i]);
+        if (std::isinf(expected.getReal())) {
+            EXPECT_EQ(result[i].getReal(), expected.getReal());
+            continue;
+        }
+        expectUlps(result[i], toStd(expected), 8);
+    }
+}
+
+// Integer exponents take the scalar function's repeated squaring in both forms of batch pow, so the answers
+// are the same bit for bit; through exp(n log z) they would differ by about 1.6 |n| ulp.
+TEST_P(ComplexMathBackends, IntegerPowMatchesScalar) {
+    const auto values = randomValues(301, 1.3, 7);
+    for (const double n : {1.0, 2.0, 3.0, 17.0, 37.0, 64.0, -1.0, -5.0, -64.0}) {
+        SCOPED_TRACE(::testing::Message() << "n = " << n);
+        const auto withScalar = pow(ComplexArray(values), Complex(n));
+        const auto withArray = pow(ComplexArray(values), ComplexArray(std::vector<Complex>(values.size(), n)));
+        for (size_t i = 0; i < values.size(); ++i) {
+            const Complex expected = pow(values[i], Complex(n));
+            EXPECT_EQ(withScalar[i].getReal(), expected.getReal());
+            EXPECT_EQ(withScalar[i].getImag(), expected.getImag());
+            EXPECT_EQ(withArray[i].getReal(), expected.getReal());
+            EXPECT_EQ(withArray[i].getImag(), expected.getImag());
+        }
+    }
+
+    const ComplexArray withZero(std::vector<Complex>{Complex(2.0), Complex()});
+    const auto cube = pow(withZero, Complex(3.0));
+    EXPECT_EQ(cube[0], Complex(8.0));
+    EXPECT_EQ(cube[1], Complex());
+    EXPECT_THROW(pow(withZero, Complex(-2.0)), std::domain_error);
+}
+
+TEST_P(ComplexMathBackends, PowMatchesScalar) {
+    const auto values = randomValues(101, 3.0, 5), exponents = randomValues(101, 2.0, 6);
+    const auto withScalar = pow(ComplexArray(values), Complex(1.5, -0.5));
+    const auto withArray = pow(ComplexArray(values), ComplexArray(exponents));
+    for (size_t i = 0; i < values.size(); ++i) {
+        expectUlps(withScalar[i], toStd(pow(values[i], Complex(1.5, -0.5))), 64);
+        expectUlps(withArray[i], toStd(pow(values[i], exponents[i])), 64);
+    }
+    EXPECT_THROW(pow(ComplexArray(3), ComplexArray(4)), std::invalid_argument);
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "../include/ComplexMatrix.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Algorithm = ComplexMatrix::Algorithm;
+using Backend = ComplexArray::SimdBackend;
+
+static ComplexMatrix randomMatrix(size_t rows, size_t cols, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<Complex> values;
+    for (size_t i = 0; i < rows * cols; ++i) values.emplace_back(dist(gen), dist(gen));
+    return ComplexMatrix(rows, cols, values.data());
+}
+
+// triple loop accumulated in long double
+static ComplexMatrix referenceProduct(const ComplexMatrix& a, const ComplexMatrix& b) {
+    ComplexMatrix result(a.getRows(), b.getColumns());
+    for (size_t i = 0; i < a.getRows(); ++i) {
+        for (size_t j = 0; j < b.getColumns(); ++j) {
+            long double re = 0.0L, im = 0.0L;
+            for (size_t k = 0; k < a.getColumns(); ++k) {
+                const Complex x = a(i, k), y = b(k, j);
+                re += static_cast<long double>(x.getReal()) * y.getReal() -
+                      static_cast<long double>(x.getImag()) * y.getImag();
+                im += static_cast<long double>(x.getReal()) * y.getImag() +
+                      static_cast<long double>(x.getImag()) * y.getReal();
+            }
+            result(i, j) = Complex(static_cast<double>(re), static_cast<double>(im));
+        }
+    }
+    return result;
+}
+
+// entries of magnitude <= 1: the error of a length k sum stays below a few k * epsilon
+static void expectProductClose(const ComplexMatrix& actual, const ComplexMatrix& expected, size_t k) {
+    ASSERT_EQ(actual.getRows(), expected.getRows());
+    ASSERT_EQ(actual.getColumns(), expected.getColumns());
+    const double tolerance = 8.0 * static_cast<double>(k) * std::numeric_limits<double>::epsilon();
+    for (size_t i = 0; i < actual.getRows(); ++i) {
+        for (size_t j = 0; j < actual.getColumns(); ++j) {
+            EXPECT_LE((actual(i, j) - expected(i, j)).amplitude(), tolerance) << "at " << i << ", " << j;
+        }
+    }
+}
+
+TEST(ComplexMatrix, ConstructionAndAccess) {
+    const Complex values[] = {Complex(1, 2), Complex(3, 4), Complex(5, 6), Complex(7, 8), Complex(9, 10),
+                              Complex(11, 12)};
+    const ComplexMatrix m(2, 3, values);
+    EXPECT_EQ(m.getRows(), 2u);
+    EXPECT_EQ(m.getColumns(), 3u);
+    EXPECT_EQ(m(1, 0), Complex(7, 8));
+    EXPECT_EQ(m.real()[5], 11.0);
+    EXPECT_EQ(m.imag()[1], 4.0);
+    EXPECT_EQ(ComplexMatrix(2, 2, Complex(1.5, -1.0))(1, 1), Complex(1.5, -1.0));
+    EXPECT_EQ(ComplexMatrix().getRows(), 0u);
+
+    EXPECT_THROW(ComplexMatrix(0, 3), std::invalid_argument);
+    EXPECT_THROW(m(2, 0), std::out_of_range);
+    EXPECT_THROW(m(0, 3), std::out_of_range);
+}
+
+TEST(ComplexMatrix, CopyOnWrite) {
+    ComplexMatrix a(2, 2, Complex(1.0, 1.0));
+    ComplexMatrix b = a;
+    EXPECT_EQ(a.real(), b.real());
+
+    b(0, 1) = Complex(5.0, -5.0);
+    EXPECT_NE(a.real(), b.real());
+    EXPECT_EQ(a(0, 1), Complex(1.0, 1.0));
+    EXPECT_EQ(b(0, 1), Complex(5.0, -5.0));
+
+    ComplexMatrix c = a;
+    c += a;
+    EXPECT_EQ(a(1, 1), Complex(1.0, 1.0));
+    EXPECT_EQ(c(1, 1), Complex(2.0, 2.0));
+
+    // a unique owner writes in place
+    const double* before = c.real();
+    c(0, 0) = 3.0;
+    EXPECT_EQ(c.real(), before);
+}
+
+TEST(ComplexMatrix, AdditionSubtractionAndEquality) {
+    // small integers, so sums and differences are exact
+    std::vector<Complex> values;
+    for (int i = 0; i < 12; ++i) values.emplace_back(i, 2 * i - 5);
+    const ComplexMatrix a(3, 4, values.data()), b = a + ComplexMatrix(3, 4, Complex(1, -1));
+    const ComplexMatrix sum = a + b;
+    EXPECT_EQ(sum(2, 3), a(2, 3) + b(2, 3));
+    EXPECT_EQ(sum - b, a);
+    EXPECT_NE(a, b);
+    EXPECT_NE(a, randomMatrix(4, 3, 1));
+    EXPECT_THROW(a + randomMatrix(4, 3, 1), std::invalid_argument);
+}
+
+TEST(ComplexMatrix, ConjugateTranspose) {
+    const ComplexMatrix a = randomMatrix(37, 70, 3);
+    const ComplexMatrix h = a.conjugateTranspose(), t = a.transpose();
+    ASSERT_EQ(h.getRows(), 70u);
+    ASSERT_EQ(h.getColumns(), 37u);
+    for (size_t i = 0; i < a.getRows(); ++i) {
+        for (size_t j = 0; j < a.getColumns(); ++j) {
+            EXPECT_EQ(h(j, i), a(i, j).conjugate());
+            EXPECT_EQ(t(j, i), a(i, j));
+        }
+    }
+    EXPECT_EQ(h.conjugateTranspose(), a);
+}
+
+TEST(ComplexMatrix, MultiplyRejectsIncompatibleShapes) {
+    EXPECT_THROW(randomMatrix(2, 3, 1) * randomMatrix(2, 3, 2), std::invalid_argument);
+    EXPECT_THROW(ComplexMatrix() * ComplexMatrix(), std::invalid_argument);
+}
+
+TEST(ComplexMatrix, ThreeMErrorIsRelativeToTheOperandMagnitudes) {
+    // the exact imaginary part is 0, but 3M gets it from (ar + ai)(br + bi) - ar*br - ai*bi, which cancels
+    const ComplexMatrix a(1, 1, Complex(1e8, 1e-8)), b(1, 1, Complex(1e8, -1e-8));
+    const Complex fourM = ComplexMatrix::multiply(a, b, Algorithm::FourM)(0, 0);
+    const Complex threeM = ComplexMatrix::multiply(a, b, Algorithm::ThreeM)(0, 0);
+    EXPECT_EQ(fourM.getReal(), threeM.getReal());
+    EXPECT_LE(std::fabs(fourM.getImag()), 4.0 * std::numeric_limits<double>::epsilon());
+    EXPECT_LE(std::fabs(threeM.getImag()), 4.0 * std::numeric_limits<double>::epsilon() * 1e16);
+}
+
+static std::string backendName(Backend backend) {
+    switch (backend) {
+    case Backend::Avx512:
+        return "Avx512";
+    case Backend::Avx2:
+        return "Avx2";
+    default:
+        return "Scalar";
+    }
+}
+
+// GEMM against the reference product, once per backend.
+class ComplexMatrixBackends : public ::testing::TestWithParam<Backend> {
+protected:
+    Backend previous = ComplexArray::activeBackend();
+
+    void SetUp() override { ComplexArray::forceBackend(GetParam()); }
+    void TearDown() override { ComplexArray::forceBackend(previous); }
+};
+
+INSTANTIATE_TEST_SUITE_P(ComplexMatrix, ComplexMatrixBackends,
+                         ::testing::Values(Backend::Scalar, Backend::Avx2, Backend::Avx512),
+                         [](const ::testing::TestParamInfo<Backend>& info) { return backendName(info.param); });
+
+// shapes that leave partial tiles and partial cache blocks in every dimension
+TEST_P(ComplexMatrixBackends, MultiplyMatchesReference) {
+    const size_t shapes[][3] = {{1, 1, 1}, {3, 5, 7}, {8, 8, 8}, {17, 9, 33}, {70, 300, 20}, {65, 513, 257}};
+    for (const auto& shape : shapes) {
+        SCOPED_TRACE(std::to_string(shape[0]) + "x" + std::to_string(shape[1]) + "x" + std::to_string(shape[2]));
+        const ComplexMatrix a = randomMatrix(shape[0], shape[1], 4), b = randomMatrix(shape[1], shape[2], 5);
+        const ComplexMatrix expected = referenceProduct(a, b);
+        expectProductClose(ComplexMatrix::multiply(a, b, Algorithm::FourM, 1), expected, shape[1]);
+        expectProductClose(ComplexMatrix::multiply(a, b, Algorithm::ThreeM, 1), expected, shape[1]);
+    }
+}
+
+TEST_P(ComplexMatrixBackends, ParallelMatchesSerial) {
+    const ComplexMatrix a = randomMatrix(200, 90, 6), b = randomMatrix(90, 130, 7);
+    for (Algorithm algorithm : {Algorithm::FourM, Algorithm::ThreeM}) {
+        EXPECT_EQ(ComplexMatrix::multiply(a, b, algorithm, 4), ComplexMatrix::multiply(a, b, algorithm, 1));
+    }
+}
+
+TEST(ComplexMatrix, MultiplyAssignAndStreamOutput) {
+    ComplexMatrix a(1, 2), b(2, 1);
+    a(0, 0) = Complex(1.0, 1.0);
+    a(0, 1) = Complex(0.0, 2.0);
+    b(0, 0) = Complex(2.0, 0.0);
+    b(1, 0) = Complex(0.0, 1.0);
+    const ComplexMatrix original = a;
+    a *= b;
+    EXPECT_EQ(a(0, 0), Complex(0.0, 2.0));
+    EXPECT_EQ(original.getColumns(), 2u);
+
+    std::ostringstream out;
+    out << original;
+    EXPECT_EQ(out.str(), "(1.00,1.00) (0.00,2.00)");
+}
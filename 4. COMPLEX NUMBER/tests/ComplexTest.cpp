@@ -5,6 +5,8 @@
 #include <cmath>
 #include <string>
 #include <iomanip>
+#include <type_traits>
+#include <vector>
 
 static constexpr double EPS = 1e-10;
 
@@ -195,4 +197,90 @@ TEST(ComplexEdgeCases, MixedTypesOperations) {
     EXPECT_DOUBLE_EQ(result1.getImag(), 3.0);
     EXPECT_DOUBLE_EQ(result2.getReal(), 7.0);
     EXPECT_DOUBLE_EQ(result2.getImag(), 3.0);
-}
\ No newline at end of file
+}
+TEST(ComplexConstexpr, ArithmeticInConstantExpressions) {
+    constexpr Complex a(1.0, 2.0), b(3.0, -1.0);
+    static_assert((a + b).getReal() == 4.0 && (a + b).getImag() == 1.0, "constexpr addition");
+    static_assert((a * b).getReal() == 5.0 && (a * b).getImag() == 5.0, "constexpr multiplication");
+    static_assert((a * b) / b == a, "constexpr division");
+    static_assert(a.conjugate() == Complex(1.0, -2.0) && a != b, "constexpr comparison");
+    static_assert(Complex(5.0).isReal() && Complex(0.0, 2.0).isImaginary(), "constexpr predicates");
+    constexpr Complex product = a * b;
+    EXPECT_EQ(product, Complex(5.0, 5.0));
+}
+
+TEST(ComplexConstexpr, TriviallyCopyable) {
+    static_assert(std::is_trivially_copyable<Complex>::value, "Complex must be trivially copyable");
+    static_assert(sizeof(Complex) == 2 * sizeof(double), "Complex must be two packed doubles");
+    SUCCEED();
+}
+
+TEST(ComplexFormat, ToCharsMatchesStreamFormatting) {
+    const Complex values[] = {Complex(3.14159, -2.71828), Complex(-0.004, 0.005), Complex(1e20, -1e-20),
+                              Complex(-123456.789, 0.0)};
+    for (const auto& c : values) {
+        std::ostringstream expected;
+        expected << std::fixed << std::setprecision(2) << "(" << c.getReal() << "," << c.getImag() << ")";
+        EXPECT_EQ(c.toString(), expected.str());
+        std::ostringstream actual;
+        actual << c;
+        EXPECT_EQ(actual.str(), expected.str());
+    }
+}
+
+TEST(ComplexFormat, PrecisionAndBufferSize) {
+    const Complex c(1.0 / 3.0, -2.0);
+    EXPECT_EQ(c.toString(5), "(0.33333,-2.00000)");
+    EXPECT_EQ(c.toString(0), "(0,-2)");
+    EXPECT_EQ(Complex(1e300, 0.0).toString().size(), 3u + 304u + 4u);
+    EXPECT_EQ(c.toString(400).size(), 2u + 400u + 1u + 3u + 400u + 2u);
+
+    char buffer[8];
+    EXPECT_EQ(c.toChars(buffer, buffer + sizeof(buffer)).ec, std::errc::value_too_large);
+    const auto result = Complex(1.0, 2.0).toChars(buffer, buffer + sizeof(buffer), 0);
+    ASSERT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string(buffer, result.ptr), "(1,2)");
+}
+
+TEST(ComplexFormat, ParseRoundTrip) {
+    const Complex c(-1.25, 1e-3);
+    EXPECT_EQ(Complex::parse(c.toString(6)), c);
+    const Complex parsed = Complex::parse(" ( 2.5 , -1e3 ) ");
+    EXPECT_DOUBLE_EQ(parsed.getReal(), 2.5);
+    EXPECT_DOUBLE_EQ(parsed.getImag(), -1000.0);
+    EXPECT_TRUE(std::isinf(Complex::parse("(inf,0)").getReal()));
+}
+
+TEST(ComplexFormat, FromCharsStopsAfterValue) {
+    const std::string text = "(1,2)(3,4)";
+    Complex c;
+    const auto result = Complex::fromChars(text.data(), text.data() + text.size(), c);
+    ASSERT_EQ(result.ec, std::errc());
+    EXPECT_EQ(result.ptr, text.data() + 5);
+    EXPECT_EQ(c, Complex(1.0, 2.0));
+}
+
+TEST(ComplexFormat, ParseRejectsMalformedText) {
+    for (const char* text : {"", "(1,2", "1,2)", "(1 2)", "(,2)", "(1,2)x", "(1,2,3)", "(+1,2)"}) {
+        EXPECT_THROW(Complex::parse(text), std::invalid_argument) << text;
+    }
+    Complex c(7.0, 7.0);
+    const std::string text = "(1e999,0)";
+    EXPECT_EQ(Complex::fromChars(text.data(), text.data() + text.size(), c).ec, std::errc::result_out_of_range);
+    EXPECT_EQ(c, Complex(7.0, 7.0));
+}
+
+TEST(ComplexFormat, BulkWriterMatchesOperator) {
+    std::vector<Complex> values;
+    for (int i = 0; i < 5000; ++i) values.emplace_back(i * 1.5, -i * 1e10);
+    values.emplace_back(1e300, -1e300);
+    std::ostringstream expected;
+    for (const auto& c : values) expected << c << '\n';
+    std::ostringstream actual;
+    writeComplex(actual, values.data(), values.size());
+    EXPECT_EQ(actual.str(), expected.str());
+
+    std::ostringstream wide;
+    writeComplex(wide, values.data(), 2, 40000, ' ');
+    EXPECT_EQ(wide.str(), values[0].toString(40000) + ' ' + values[1].toString(40000) + ' ');
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../include/Fft.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+static std::vector<Complex> randomSignal(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<Complex> values;
+    for (size_t i = 0; i < n; ++i) values.emplace_back(dist(gen), dist(gen));
+    return values;
+}
+
+// O(n^2) DFT accumulated in long double, accurate enough to serve as the exact answer
+static std::vector<Complex> referenceDft(const std::vector<Complex>& x) {
+    const size_t n = x.size();
+    const long double pi = 3.141592653589793238462643383279502884L;
+    std::vector<Complex> result(n);
+    for (size_t k = 0; k < n; ++k) {
+        long double re = 0.0L, im = 0.0L;
+        for (size_t j = 0; j < n; ++j) {
+            const long double angle = -2.0L * pi * static_cast<long double>(j * k % n) / n;
+            const long double c = std::cos(angle), s = std::sin(angle);
+            re += x[j].getReal() * c - x[j].getImag() * s;
+            im += x[j].getReal() * s + x[j].getImag() * c;
+        }
+        result[k] = Complex(static_cast<double>(re), static_cast<double>(im));
+    }
+    return result;
+}
+
+// Error bound of a floating point FFT: a few epsilons per stage, relative to the signal energy.
+static void expectClose(const std::vector<Complex>& actual, const std::vector<Complex>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    double norm = 0.0;
+    for (const auto& value : expected) norm = std::max(norm, value.amplitude());
+    const double stages = std::log2(static_cast<double>(expected.size()) + 1.0);
+    const double tolerance = 4.0 * stages * std::numeric_limits<double>::epsilon() * std::max(norm, 1.0);
+    for (size_t k = 0; k < actual.size(); ++k) {
+        EXPECT_LE((actual[k] - expected[k]).amplitude(), tolerance) << "bin " << k << " of " << actual.size();
+    }
+}
+
+// radix 2, 3, 4, 5, their mixtures and leftover primes
+static const size_t LENGTHS[] = {1,  2,  3,  4,  5,  6,  7,   8,   9,   12,  15, 16,
+                                 25, 30, 49, 60, 64, 97, 100, 120, 243, 360, 512};
+
+TEST(Fft, MatchesReferenceDft) {
+    for (size_t n : LENGTHS) {
+        const auto signal = randomSignal(n, static_cast<unsigned>(n));
+        expectClose(fft(signal), referenceDft(signal));
+    }
+}
+
+TEST(Fft, InverseRoundTrip) {
+    for (size_t n : LENGTHS) {
+        const auto signal = randomSignal(n, static_cast<unsigned>(n) + 1);
+        expectClose(ifft(fft(signal)), signal);
+    }
+}
+
+TEST(Fft, ImpulseGivesFlatSpectrum) {
+    std::vector<Complex> impulse(60);
+    impulse[0] = 1.0;
+    for (const auto& bin : fft(impulse)) EXPECT_EQ(bin, Complex(1.0, 0.0));
+}
+
+TEST(Fft, InPlaceMatchesOutOfPlace) {
+    const auto signal = randomSignal(120, 5);
+    auto buffer = signal;
+    FftPlan::get(120)->forward(buffer.data(), buffer.data());
+    EXPECT_EQ(buffer, fft(signal));
+}
+
+TEST(Fft, ParallelMatchesSerial) {
+    for (size_t n : {size_t(1) << 12, size_t(3 * 5 * 256), size_t(7 * 11 * 13)}) {
+        const auto signal = randomSignal(n, 6);
+        FftPlan plan(n);
+        std::vector<Complex> serial(n), parallel(n);
+        plan.forward(signal.data(), serial.data(), 1);
+        plan.forward(signal.data(), parallel.data(), 4);
+        for (size_t k = 0; k < n; ++k) {
+            EXPECT_EQ(serial[k].getReal(), parallel[k].getReal());
+            EXPECT_EQ(serial[k].getImag(), parallel[k].getImag());
+        }
+    }
+}
+
+TEST(Fft, ComplexArrayMatchesVector) {
+    const auto signal = randomSignal(96, 7);
+    EXPECT_EQ(fft(ComplexArray(signal)).toVector(), fft(signal));
+    EXPECT_EQ(ifft(ComplexArray(signal)).toVector(), ifft(signal));
+}
+
+TEST(Fft, PlansAreCached) {
+    const auto plan = FftPlan::get(360);
+    EXPECT_EQ(plan, FftPlan::get(360));
+    EXPECT_EQ(plan->size(), 360u);
+    FftPlan::clearCache();
+    EXPECT_NE(plan, FftPlan::get(360));
+}
+
+TEST(Fft, ZeroLength) {
+    EXPECT_THROW(FftPlan(0), std::invalid_argument);
+    EXPECT_TRUE(fft(std::vector<Complex>()).empty());
+}
+
+TEST(RealFft, MatchesComplexTransform) {
+    for (size_t n : LENGTHS) {
+        std::vector<double> signal;
+        for (const auto& value : randomSignal(n, static_cast<unsigned>(n) + 2)) signal.push_back(value.getReal());
+        auto expected = referenceDft(std::vector<Complex>(signal.begin(), signal.end()));
+        expected.resize(n / 2 + 1);
+        expectClose(rfft(signal), expected);
+    }
+}
+
+TEST(RealFft, InverseRoundTrip) {
+    for (size_t n : LENGTHS) {
+        std::vector<double> signal;
+        for (const auto& value : randomSignal(n, static_cast<unsigned>(n) + 3)) signal.push_back(value.getImag());
+        const auto restored = irfft(rfft(signal), n);
+        ASSERT_EQ(restored.size(), n);
+        for (size_t j = 0; j < n; ++j) EXPECT_NEAR(restored[j], signal[j], 1e-14) << j << " of " << n;
+    }
+}
+
+TEST(RealFft, RejectsWrongSpectrumSize) {
+    EXPECT_THROW(irfft(std::vector<Complex>(4), 8), std::invalid_argument);
+}
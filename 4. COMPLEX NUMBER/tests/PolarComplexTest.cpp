@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "../include/ComplexMath.h"
+#include "../include/PolarComplex.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Backend = ComplexArray::SimdBackend;
+
+static void expectComplexNear(const Complex& actual, const Complex& expected, double tolerance) {
+    EXPECT_NEAR(actual.getReal(), expected.getReal(), tolerance) << "expected " << expected;
+    EXPECT_NEAR(actual.getImag(), expected.getImag(), tolerance) << "expected " << expected;
+}
+
+TEST(PolarComplex, Construction) {
+    const PolarComplex p(2.0, M_PI / 2);
+    EXPECT_EQ(p.magnitude(), 2.0);
+    EXPECT_EQ(p.angle(), M_PI / 2);
+    EXPECT_NEAR(PolarComplex(1.0, 5 * M_PI / 2).angle(), M_PI / 2, 1e-12);
+    EXPECT_NEAR(PolarComplex(1.0, -5 * M_PI / 2).angle(), -M_PI / 2, 1e-12);
+    EXPECT_EQ(PolarComplex().magnitude(), 0.0);
+
+    EXPECT_THROW(PolarComplex(-1.0, 0.0), std::invalid_argument);
+    EXPECT_THROW(PolarComplex(std::nan(""), 0.0), std::invalid_argument);
+
+    const PolarComplex fromCartesian(Complex(0.0, -3.0));
+    EXPECT_EQ(fromCartesian.magnitude(), 3.0);
+    EXPECT_EQ(fromCartesian.angle(), -M_PI / 2);
+}
+
+TEST(PolarComplex, MultiplyDivideAndPow) {
+    const PolarComplex a(2.0, 3.0), b(4.0, 1.0);
+    const PolarComplex product = a * b;
+    EXPECT_EQ(product.magnitude(), 8.0);
+    EXPECT_NEAR(product.angle(), 4.0 - 2 * M_PI, 1e-12);
+    expectComplexNear(product.toComplex(), a.toComplex() * b.toComplex(), 1e-12);
+
+    const PolarComplex quotient = b / a;
+    EXPECT_EQ(quotient.magnitude(), 2.0);
+    EXPECT_NEAR(quotient.angle(), -2.0, 1e-12);
+    EXPECT_THROW(a / PolarComplex(), std::runtime_error);
+
+    EXPECT_EQ(a * a.inverse(), PolarComplex(1.0, 0.0));
+    EXPECT_EQ(a * a.conjugate(), PolarComplex(4.0, 0.0));
+    EXPECT_EQ(a.pow(3.0), a * a * a);
+    EXPECT_EQ(PolarComplex(4.0, M_PI).pow(0.5), PolarComplex(2.0, M_PI / 2));
+}
+
+TEST(PolarComplex, ToComplexIsCachedUntilTheValueChanges) {
+    PolarComplex p(2.0, M_PI / 2);
+    const Complex& first = p.toComplex();
+    expectComplexNear(first, Complex(0.0, 2.0), 1e-15);
+    EXPECT_EQ(&p.toComplex(), &first);
+
+    p *= PolarComplex(1.0, M_PI / 2);
+    expectComplexNear(p.toComplex(), Complex(-2.0, 0.0), 1e-15);
+
+    // converting from Cartesian keeps the exact value
+    const Complex c(0.1, 0.7);
+    EXPECT_EQ(PolarComplex(c).toComplex().getReal(), 0.1);
+    EXPECT_EQ(PolarComplex(c).toComplex().getImag(), 0.7);
+}
+
+TEST(PolarComplex, EqualityAndOutput) {
+    EXPECT_EQ(PolarComplex(1.0, M_PI), PolarComplex(1.0, -M_PI));
+    EXPECT_EQ(PolarComplex(0.0, 1.0), PolarComplex(0.0, -2.0));
+    EXPECT_NE(PolarComplex(1.0, 1.0), PolarComplex(1.0, 1.1));
+
+    std::ostringstream out;
+    out << PolarComplex(2.5, -1.0);
+    EXPECT_EQ(out.str(), "2.50*exp(-1.00i)");
+}
+
+static std::string backendName(Backend backend) {
+    switch (backend) {
+    case Backend::Avx512:
+        return "Avx512";
+    case Backend::Avx2:
+        return "Avx2";
+    default:
+        return "Scalar";
+    }
+}
+
+// Batch conversions against the scalar ones, once per backend.
+class PolarConversionBackends : public ::testing::TestWithParam<Backend> {
+protected:
+    Backend previous = ComplexArray::activeBackend();
+
+    void SetUp() override { ComplexArray::forceBackend(GetParam()); }
+    void TearDown() override { ComplexArray::forceBackend(previous); }
+};
+
+INSTANTIATE_TEST_SUITE_P(PolarComplex, PolarConversionBackends,
+                         ::testing::Values(Backend::Scalar, Backend::Avx2, Backend::Avx512),
+                         [](const ::testing::TestParamInfo<Backend>& info) { return backendName(info.param); });
+
+TEST_P(PolarConversionBackends, ToPolarMatchesScalar) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    std::vector<Complex> values;
+    for (int i = 0; i < 203; ++i) values.emplace_back(dist(gen), dist(gen));
+    // zero, signed zeros, subnormals and infinities go to std::atan2
+    const double inf = std::numeric_limits<double>::infinity();
+    values.insert(values.end(), {Complex(0.0, 0.0), Complex(-3.0, 0.0), Complex(-3.0, -0.0), Complex(1e-310, 2e-310),
+                                 Complex(inf, 1.0), Complex(1e300, -1e300), Complex(0.0, -2.0)});
+
+    const ComplexArray z(values);
+    std::vector<double> magnitude(z.size()), angle(z.size());
+    toPolar(z, magnitude.data(), angle.data());
+    for (size_t i = 0; i < values.size(); ++i) {
+        SCOPED_TRACE("z = " + values[i].toString() + " at " + std::to_string(i));
+        const double epsilon = std::numeric_limits<double>::epsilon();
+        if (std::isinf(values[i].amplitude()))
+            EXPECT_EQ(magnitude[i], values[i].amplitude());
+        else
+            EXPECT_NEAR(magnitude[i], values[i].amplitude(), 2 * epsilon * values[i].amplitude());
+        const double expected = std::atan2(values[i].getImag(), values[i].getReal());
+        EXPECT_NEAR(angle[i], expected, 4 * epsilon * std::fabs(expected));
+        EXPECT_EQ(std::signbit(angle[i]), std::signbit(expected));
+    }
+}
+
+TEST_P(PolarConversionBackends, FromPolarMatchesScalar) {
+    std::mt19937 gen(2);
+    std::uniform_real_distribution<double> magnitudes(0.0, 100.0), angles(-M_PI, M_PI);
+    std::vector<double> magnitude, angle;
+    for (int i = 0; i < 203; ++i) {
+        magnitude.push_back(magnitudes(gen));
+        angle.push_back(angles(gen));
+    }
+    // angles past the kernel's reduction range and an infinite magnitude go to std::sin and std::cos
+    magnitude.insert(magnitude.end(), {0.0, 1.0, 1.0, std::numeric_limits<double>::infinity()});
+    angle.insert(angle.end(), {1.0, 1e10, -1e300, 0.5});
+
+    const ComplexArray z = fromPolar(magnitude.data(), angle.data(), magnitude.size());
+    ASSERT_EQ(z.size(), magnitude.size());
+    for (size_t i = 0; i < magnitude.size(); ++i) {
+        SCOPED_TRACE("at " + std::to_string(i));
+        const Complex expected(magnitude[i] * std::cos(angle[i]), magnitude[i] * std::sin(angle[i]));
+        if (std::isinf(magnitude[i])) {
+            EXPECT_EQ(z[i].getReal(), expected.getReal());
+            EXPECT_EQ(z[i].getImag(), expected.getImag());
+            continue;
+        }
+        expectComplexNear(z[i], expected, 4 * std::numeric_limits<double>::epsilon() * magnitude[i]);
+    }
+}
+
+TEST_P(PolarConversionBackends, RoundTrip) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-1e3, 1e3);
+    std::vector<Complex> values;
+    for (int i = 0; i < 101; ++i) values.emplace_back(dist(gen), dist(gen));
+    const ComplexArray z(values);
+    std::vector<double> magnitude(z.size()), angle(z.size());
+    toPolar(z, magnitude.data(), angle.data());
+    const ComplexArray back = fromPolar(magnitude.data(), angle.data(), z.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        expectComplexNear(back[i], values[i], 8 * std::numeric_limits<double>::epsilon() * values[i].amplitude());
+    }
+}
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "/root/repo/4. COMPLEX NUMBER/_gate_build/lib/libgtest_main.a"
+)
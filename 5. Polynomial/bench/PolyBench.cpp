@@ -0,0 +1,146 @@
+// Run with --benchmark_format=json (or csv) for machine-readable output.
+#include <benchmark/benchmark.h>
+#include "ModPoly.h"
+#include "MultiPoly.h"
+#include "Poly.h"
+#include <map>
+#include <random>
+#include <sstream>
+#include <vector>
+
+// range(0): degree, range(1): percentage of non-zero coefficients
+static Poly makePoly(int degree, int densityPercent, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(1, 100);
+    std::uniform_real_distribution<double> coefficient(-10.0, 10.0);
+    std::map<int, double> terms;
+    for (int exponent = 0; exponent < degree; ++exponent) {
+        if (percent(rng) <= densityPercent) terms[exponent] = coefficient(rng);
+    }
+    terms[degree] = 1.0;
+    return Poly(terms);
+}
+
+static void shapes(benchmark::internal::Benchmark* b) {
+    for (int degree : {16, 128, 1024}) {
+        for (int density : {100, 10, 1}) {
+            b->Args({degree, density});
+        }
+    }
+    b->ArgNames({"degree", "density"});
+}
+
+static void BM_MultiplyAssign(benchmark::State& state) {
+    const Poly a = makePoly(state.range(0), state.range(1), 1);
+    const Poly b = makePoly(state.range(0), state.range(1), 2);
+    for (auto _ : state) {
+        Poly p = a;
+        p *= b;
+        benchmark::DoNotOptimize(p);
+    }
+}
+BENCHMARK(BM_MultiplyAssign)->Apply(shapes);
+
+static void BM_AddAssign(benchmark::State& state) {
+    Poly p = makePoly(state.range(0), state.range(1), 1);
+    const Poly b = makePoly(state.range(0), state.range(1), 2);
+    bool add = true;
+    for (auto _ : state) {
+        // alternate with subtraction so the operand does not grow
+        if (add)
+            p += b;
+        else
+            p -= b;
+        add = !add;
+        benchmark::DoNotOptimize(p);
+    }
+}
+BENCHMARK(BM_AddAssign)->Apply(shapes);
+
+static void BM_Evaluate(benchmark::State& state) {
+    const Poly p = makePoly(state.range(0), state.range(1), 1);
+    double x = 0.999;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p(x));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Evaluate)->Apply(shapes);
+
+static void BM_StreamInsertion(benchmark::State& state) {
+    const Poly p = makePoly(state.range(0), state.range(1), 1);
+    std::ostringstream out;
+    for (auto _ : state) {
+        out.str("");
+        out << p;
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_StreamInsertion)->Apply(shapes);
+
+// Exact product of two dense polynomials of degree range(0) modulo an NTT-friendly prime
+static void BM_NttMultiply(benchmark::State& state) {
+    using Mod = ModInt<998244353>;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<long long> coefficient(0, Mod::modulus() - 1);
+    std::map<int, Mod> termsA, termsB;
+    for (int exponent = 0; exponent <= state.range(0); ++exponent) {
+        termsA.emplace_hint(termsA.end(), exponent, coefficient(rng));
+        termsB.emplace_hint(termsB.end(), exponent, coefficient(rng));
+    }
+    const ModPoly<998244353> a(termsA), b(termsB);
+    for (auto _ : state) {
+        ModPoly<998244353> p = a;
+        p *= b;
+        benchmark::DoNotOptimize(p);
+    }
+}
+BENCHMARK(BM_NttMultiply)->RangeMultiplier(16)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond);
+
+// The same products on dense coefficient vectors, without the term map
+static void BM_NttMultiplyDense(benchmark::State& state) {
+    using Mod = ModInt<998244353>;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<long long> coefficient(0, Mod::modulus() - 1);
+    std::vector<Mod> a(state.range(0) + 1), b(state.range(0) + 1);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = coefficient(rng);
+        b[i] = coefficient(rng);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nttMultiply(a, b));
+    }
+}
+BENCHMARK(BM_NttMultiplyDense)->RangeMultiplier(16)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond);
+
+// range(0): number of variables; operands are (1 + x1 + ... + xn)^4
+static MultiPoly denseMultiPoly(int variables) {
+    MultiPoly base(variables, 1.0);
+    for (int v = 1; v <= variables; ++v) base += MultiPoly::variable(variables, v);
+    return base * base * base * base;
+}
+
+static void BM_MultiPolyMultiply(benchmark::State& state) {
+    const MultiPoly a = denseMultiPoly(state.range(0));
+    for (auto _ : state) {
+        MultiPoly p = a;
+        p *= a;
+        benchmark::DoNotOptimize(p);
+    }
+}
+BENCHMARK(BM_MultiPolyMultiply)->DenseRange(3, 6);
+
+static void BM_MultiPolyEvaluate(benchmark::State& state) {
+    const int variables = state.range(0);
+    const size_t count = 4096;
+    const MultiPoly p = denseMultiPoly(variables);
+    std::vector<double> points(variables * count, 0.5), values(count);
+    for (auto _ : state) {
+        p.evaluate(points.data(), count, values.data());
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_MultiPolyEvaluate)->DenseRange(3, 6);
+
+BENCHMARK_MAIN();
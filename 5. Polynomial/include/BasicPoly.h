@@ -0,0 +1,437 @@
+#pragma once
+#include <charconv>
+#include <complex>
+#include <iosfwd>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Strategy used by operator*= for the product of two term maps.
+// Coefficient types with a faster algorithm specialize it (see ModPoly.h).
+template <typename Coeff>
+struct PolyMultiplication
+{
+    // Returns false when the caller should fall back to the schoolbook product.
+    static bool multiply(const std::map<int, Coeff>&, const std::map<int, Coeff>&, std::map<int, Coeff>&) {
+        return false;
+    }
+};
+
+// Sparse polynomial storing only the non-zero coefficients. Poly is the double instantiation.
+template <typename Coeff>
+class BasicPoly
+{
+  public:
+    BasicPoly(Coeff value = Coeff());
+    BasicPoly(const std::map<int, Coeff>& newTerms);
+
+    BasicPoly operator-() const&;
+    BasicPoly operator-() &&;
+
+    BasicPoly& operator+=(const BasicPoly& p2);
+    BasicPoly& operator+=(BasicPoly&& p2);
+    BasicPoly& operator-=(const BasicPoly& p2);
+    BasicPoly& operator-=(BasicPoly&& p2);
+    BasicPoly& operator*=(const BasicPoly& p2);
+
+    // this += alpha * p, without building the scaled temporary
+    BasicPoly& addScaled(const BasicPoly& p, Coeff alpha);
+    // this += a * b, accumulating directly into the existing terms
+    BasicPoly& multiplyAccumulate(const BasicPoly& a, const BasicPoly& b);
+
+    Coeff operator[](int exponent) const;
+    Coeff& operator[](int exponent);
+    Coeff operator()(Coeff value) const;
+
+    BasicPoly derivative() const;
+    // Coefficients are divided exactly: throws std::domain_error when an integer coefficient is not a multiple
+    // of exponent + 1, or when exponent + 1 is zero in the coefficient type (modular coefficients).
+    BasicPoly integral(Coeff constant = Coeff()) const;
+
+    // The members below are only available for Poly (double coefficients); other types fail to compile.
+
+    // All complex roots, repeated according to multiplicity. Throws for the zero polynomial.
+    std::vector<std::complex<double>> roots() const;
+    // Real roots in ascending order; roots with |imag| <= tolerance * max(1, |root|) count as real.
+    std::vector<double> realRoots(double tolerance = 1e-7) const;
+
+    // Text in the notation written by operator<<, e.g. "3x^2 - x + 1". Same contract as std::from_chars.
+    static std::from_chars_result fromChars(const char* first, const char* last, BasicPoly& result);
+    // Throws std::invalid_argument unless the whole text is a polynomial.
+    static BasicPoly parse(std::string_view text);
+    // Writes the operator<< representation into [first, last). Same contract as std::to_chars.
+    std::to_chars_result toChars(char* first, char* last) const;
+
+    // Binary form: varint term count, then per term a varint exponent delta with an "integer coefficient" flag,
+    // followed by a zigzag varint for integer coefficients or 8 little-endian bytes otherwise.
+    void serialize(std::vector<unsigned char>& out) const;
+    // Returns the position after the decoded polynomial. Throws std::invalid_argument on malformed input.
+    static const unsigned char* deserialize(const unsigned char* first, const unsigned char* last,
+                                            BasicPoly& result);
+
+    friend BasicPoly operator+(BasicPoly p1, const BasicPoly& p2) {
+        p1 += p2;
+        return p1;
+    }
+
+    friend BasicPoly operator+(const BasicPoly& p1, BasicPoly&& p2) {
+        p2 += p1;
+        return std::move(p2);
+    }
+
+    friend BasicPoly operator-(BasicPoly p1, const BasicPoly& p2) {
+        p1 -= p2;
+        return p1;
+    }
+
+    friend BasicPoly operator-(const BasicPoly& p1, BasicPoly&& p2) {
+        BasicPoly difference = -std::move(p2);
+        difference += p1;
+        return difference;
+    }
+
+    friend BasicPoly operator*(BasicPoly p1, const BasicPoly& p2) {
+        p1 *= p2;
+        return p1;
+    }
+
+    friend bool operator==(const BasicPoly& p1, const BasicPoly& p2) { return p1.getTerms() == p2.getTerms(); }
+    friend bool operator!=(const BasicPoly& p1, const BasicPoly& p2) { return !(p1 == p2); }
+
+    friend std::ostream& operator<<(std::ostream& out, const BasicPoly& p) { return p.write(out); }
+
+    // p(q(x))
+    friend BasicPoly composition(const BasicPoly& p, const BasicPoly& q) { return p.composeWith(q); }
+
+  private:
+    std::map<int, Coeff> terms;
+    void removeZeros();
+    void negate();
+    BasicPoly composeWith(const BasicPoly& q) const;
+    std::ostream& write(std::ostream& out) const;
+    static BasicPoly power(BasicPoly base, int exponent);
+    static Coeff power(Coeff base, int exponent);
+    static std::to_chars_result formatTerm(char* first, char* last, int exponent, Coeff coefficient, bool leading,
+                                           int precision, std::ios_base::fmtflags flags);
+    const std::map<int, Coeff>& getTerms() const;
+};
+
+template <typename Coeff>
+BasicPoly<Coeff>::BasicPoly(Coeff value) {
+    if (value != Coeff()) {
+        terms[0] = value;
+    }
+}
+
+template <typename Coeff>
+BasicPoly<Coeff>::BasicPoly(const std::map<int, Coeff>& terms) : terms(terms) {
+    for (const auto& term : terms) {
+        if (term.first < 0) {
+            throw std::invalid_argument("only non-negative exponents are allowed");
+        }
+    }
+    removeZeros();
+}
+
+template <typename Coeff>
+BasicPoly<Coeff> BasicPoly<Coeff>::operator-() const& {
+    BasicPoly result = *this;
+    result.negate();
+    return result;
+}
+
+template <typename Coeff>
+BasicPoly<Coeff> BasicPoly<Coeff>::operator-() && {
+    negate();
+    return std::move(*this);
+}
+
+template <typename Coeff>
+BasicPoly<Coeff>& BasicPoly<Coeff>::operator+=(const BasicPoly& p2) {
+    return addScaled(p2, Coeff(1));
+}
+
+template <typename Coeff>
+BasicPoly<Coeff>& BasicPoly<Coeff>::operator+=(BasicPoly&& p2) {
+    // addition is commutative, so accumulate into whichever operand already holds more terms
+    if (p2.terms.size() > terms.size()) terms.swap(p2.terms);
+    return addScaled(p2, Coeff(1));
+}
+
+template <typename Coeff>
+BasicPoly<Coeff>& BasicPoly<Coeff>::operator-=(const BasicPoly& p2) {
+    return addScaled(p2, -Coeff(1));
+}
+
+template <typename Coeff>
+BasicPoly<Coeff>& BasicPoly<Coeff>::operator-=(BasicPoly&& p2) {
+    if (p2.terms.size() > terms.size()) {
+        // this - p2 == -(p2 - this)
+        terms.swap(p2.terms);
+        negate();
+        return addScaled(p2, Coeff(1));
+    }
+    return addScaled(p2, -Coeff(1));
+}
+
+template <typename Coeff>
+BasicPoly<Coeff>& BasicPoly<Coeff>::operator*=(const BasicPoly& p2) {
+    BasicPoly product;
+    if (!PolyMultiplication<Coeff>::multiply(terms, p2.terms, product.terms)) {
+        product.multiplyAccumulate(*this, p2);
+    }
+    terms.swap(product.terms);
+    return *this;
+}
+
+template <typename Coeff>
+BasicPoly<Coeff>& BasicPoly<Coeff>::addScaled(const BasicPoly& p, Coeff alpha) {
+    if (this == &p) {
+        for (auto& term : terms) {
+            term.second *= Coeff(1) + alpha;
+        }
+        removeZeros();
+        return *this;
+    }
+
+    // p.terms is sorted, so the position after the last touched term is a good insertion hint
+    auto hint = terms.begin();
+    for (const auto& term : p.terms) {
+        auto it = terms.try_emplace(hint, term.first, Coeff());
+        it->second += alpha * term.second;
+        if (it->second == Coeff())
+            hint = terms.erase(it);
+        else
+            hint = std::next(it);
+    }
+    return *this;
+}
+
+template <typename Coeff>
+BasicPoly<Coeff>& BasicPoly<Coeff>::multiplyAccumulate(const BasicPoly& a, const BasicPoly& b) {
+    if (this == &a || this == &b) {
+        return *this += a * b;
+    }
+
+    for (const auto& termA : a.terms) {
+        auto hint = terms.begin();
+        for (const auto& termB : b.terms) {
+            auto it = terms.try_emplace(hint, termA.first + termB.first, Coeff());
+            it->second += termA.second * termB.second;
+            hint = std::next(it);
+        }
+    }
+    removeZeros();
+    return *this;
+}
+
+template <typename Coeff>
+const std::map<int, Coeff>& BasicPoly<Coeff>::getTerms() const {
+    return terms;
+}
+
+template <typename Coeff>
+Coeff BasicPoly<Coeff>::operator[](int exponent) const {
+    auto it = terms.find(exponent);
+    return it != terms.end() ? it->second : Coeff();
+}
+
+template <typename Coeff>
+Coeff& BasicPoly<Coeff>::operator[](int exponent) {
+    if (exponent < 0) {
+        throw std::invalid_argument("only non-negative exponents are allowed");
+    }
+    return terms[exponent];
+}
+
+template <typename Coeff>
+Coeff BasicPoly<Coeff>::operator()(Coeff value) const {
+    // Horner's scheme over the non-zero terms; gaps between exponents become powers of value
+    Coeff result = Coeff();
+    int previousExponent = terms.empty() ? 0 : terms.rbegin()->first;
+    for (auto it = terms.rbegin(); it != terms.rend(); ++it) {
+        result = result * power(value, previousExponent - it->first) + it->second;
+        previousExponent = it->first;
+    }
+    return result * power(value, previousExponent);
+}
+
+template <typename Coeff>
+BasicPoly<Coeff> BasicPoly<Coeff>::derivative() const {
+    BasicPoly result;
+    for (const auto& term : terms) {
+        if (term.first == 0) continue;
+        // the exponent can vanish in the coefficient type, e.g. modulo P
+        const Coeff coefficient = Coeff(term.first) * term.second;
+        if (coefficient != Coeff()) result.terms.emplace_hint(result.terms.end(), term.first - 1, coefficient);
+    }
+    return result;
+}
+
+template <typename Coeff>
+BasicPoly<Coeff> BasicPoly<Coeff>::integral(Coeff constant) const {
+    BasicPoly result(constant);
+    for (const auto& term : terms) {
+        const Coeff divisor = Coeff(term.first + 1);
+        if (divisor == Coeff()) {
+            throw std::domain_error("integral divides by an exponent that is zero in the coefficient type");
+        }
+        if constexpr (std::is_integral_v<Coeff>) {
+            if (term.second % divisor != 0) {
+                throw std::domain_error("integral has a coefficient that is not an integer");
+            }
+        }
+        result.terms.emplace_hint(result.terms.end(), term.first + 1, term.second / divisor);
+    }
+    return result;
+}
+
+template <typename Coeff>
+void BasicPoly<Coeff>::negate() {
+    for (auto& term : terms) {
+        term.second = -term.second;
+    }
+}
+
+template <typename Coeff>
+void BasicPoly<Coeff>::removeZeros() {
+    for (auto it = terms.begin(); it != terms.end();) {
+        if (it->second == Coeff()) {
+            it = terms.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+template <typename Coeff>
+BasicPoly<Coeff> BasicPoly<Coeff>::power(BasicPoly base, int exponent) {
+    BasicPoly result = Coeff(1);
+    while (exponent > 0) {
+        if (exponent & 1) result *= base;
+        exponent >>= 1;
+        if (exponent > 0) base *= base;
+    }
+    return result;
+}
+
+template <typename Coeff>
+Coeff BasicPoly<Coeff>::power(Coeff base, int exponent) {
+    Coeff result = Coeff(1);
+    while (exponent > 0) {
+        if (exponent & 1) result *= base;
+        exponent >>= 1;
+        if (exponent > 0) base *= base;
+    }
+    return result;
+}
+
+template <typename Coeff>
+BasicPoly<Coeff> BasicPoly<Coeff>::composeWith(const BasicPoly& q) const {
+    if (terms.empty()) return BasicPoly();
+
+    // Horner's scheme over the non-zero terms only: gaps between exponents become powers of q
+    BasicPoly result;
+    int previousExponent = terms.rbegin()->first;
+    for (auto it = terms.rbegin(); it != terms.rend(); ++it) {
+        if (previousExponent > it->first) result *= power(q, previousExponent - it->first);
+        result += it->second;
+        previousExponent = it->first;
+    }
+    if (previousExponent > 0) result *= power(q, previousExponent);
+    return result;
+}
+
+template <typename Coeff>
+std::ostream& BasicPoly<Coeff>::write(std::ostream& out) const {
+    bool leading = true;
+    for (auto it = terms.rbegin(); it != terms.rend(); ++it) {
+        Coeff coefficient = it->second;
+        if (coefficient == Coeff()) continue;
+        // signed coefficients print their sign as an operator, as the double output does
+        bool negative = false;
+        if constexpr (std::is_signed_v<Coeff>) negative = coefficient < Coeff();
+        if (negative) coefficient = -coefficient;
+        if (!leading)
+            out << (negative ? " - " : " + ");
+        else if (negative)
+            out << "-";
+        if (it->first == 0 || coefficient != Coeff(1)) out << coefficient;
+        if (it->first != 0) out << "x";
+        if (it->first > 1) out << "^" << it->first;
+        leading = false;
+    }
+    if (leading) out << "0";
+    return out;
+}
+
+// The Poly-only members. Poly.h declares their double specializations, so these bodies are only instantiated
+// for other coefficient types, where they stop the build instead of leaving an undefined symbol for the linker.
+template <typename>
+inline constexpr bool POLY_ONLY = false;
+
+template <typename Coeff>
+std::vector<std::complex<double>> BasicPoly<Coeff>::roots() const {
+    static_assert(POLY_ONLY<Coeff>, "roots() is only available for Poly");
+    return {};
+}
+
+template <typename Coeff>
+std::vector<double> BasicPoly<Coeff>::realRoots(double) const {
+    static_assert(POLY_ONLY<Coeff>, "realRoots() is only available for Poly");
+    return {};
+}
+
+template <typename Coeff>
+std::from_chars_result BasicPoly<Coeff>::fromChars(const char* first, const char*, BasicPoly&) {
+    static_assert(POLY_ONLY<Coeff>, "fromChars() is only available for Poly");
+    return {first, std::errc::invalid_argument};
+}
+
+template <typename Coeff>
+BasicPoly<Coeff> BasicPoly<Coeff>::parse(std::string_view) {
+    static_assert(POLY_ONLY<Coeff>, "parse() is only available for Poly");
+    return BasicPoly();
+}
+
+template <typename Coeff>
+std::to_chars_result BasicPoly<Coeff>::toChars(char* first, char*) const {
+    static_assert(POLY_ONLY<Coeff>, "toChars() is only available for Poly");
+    return {first, std::errc::value_too_large};
+}
+
+template <typename Coeff>
+void BasicPoly<Coeff>::serialize(std::vector<unsigned char>&) const {
+    static_assert(POLY_ONLY<Coeff>, "serialize() is only available for Poly");
+}
+
+template <typename Coeff>
+const unsigned char* BasicPoly<Coeff>::deserialize(const unsigned char* first, const unsigned char*, BasicPoly&) {
+    static_assert(POLY_ONLY<Coeff>, "deserialize() is only available for Poly");
+    return first;
+}
+
+template <typename Coeff>
+std::vector<BasicPoly<Coeff>> derivatives(const std::vector<BasicPoly<Coeff>>& polys) {
+    std::vector<BasicPoly<Coeff>> result;
+    result.reserve(polys.size());
+    for (const auto& p : polys) {
+        result.push_back(p.derivative());
+    }
+    return result;
+}
+
+template <typename Coeff>
+std::vector<BasicPoly<Coeff>> integrals(const std::vector<BasicPoly<Coeff>>& polys, Coeff constant = Coeff()) {
+    std::vector<BasicPoly<Coeff>> result;
+    result.reserve(polys.size());
+    for (const auto& p : polys) {
+        result.push_back(p.integral(constant));
+    }
+    return result;
+}
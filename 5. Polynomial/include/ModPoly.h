@@ -0,0 +1,255 @@
+#pragma once
+#include "BasicPoly.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Integer modulo the odd prime P, stored in Montgomery form (value * 2^32 mod P).
+template <uint32_t P>
+class ModInt
+{
+    static_assert(P % 2 == 1 && P < (1u << 30), "Montgomery form needs an odd modulus below 2^30");
+
+  public:
+    constexpr ModInt() : value(0) {}
+    constexpr ModInt(long long x) : value(reduce(static_cast<uint64_t>(normalize(x)) * R2)) {}
+
+    static constexpr uint32_t modulus() { return P; }
+    constexpr uint32_t get() const { return reduce(value); }
+
+    constexpr ModInt operator-() const { return fromMontgomery(value == 0 ? 0 : P - value); }
+
+    constexpr ModInt& operator+=(ModInt other) {
+        value += other.value;
+        if (value >= P) value -= P;
+        return *this;
+    }
+
+    constexpr ModInt& operator-=(ModInt other) {
+        value += P - other.value;
+        if (value >= P) value -= P;
+        return *this;
+    }
+
+    constexpr ModInt& operator*=(ModInt other) {
+        value = reduce(static_cast<uint64_t>(value) * other.value);
+        return *this;
+    }
+
+    // P must be prime for the inverse to exist
+    constexpr ModInt& operator/=(ModInt other) { return *this *= other.inverse(); }
+
+    constexpr ModInt pow(uint64_t exponent) const {
+        ModInt result = 1, base = *this;
+        while (exponent > 0) {
+            if (exponent & 1) result *= base;
+            base *= base;
+            exponent >>= 1;
+        }
+        return result;
+    }
+
+    constexpr ModInt inverse() const { return pow(P - 2); }
+
+    friend constexpr ModInt operator+(ModInt a, ModInt b) { return a += b; }
+    friend constexpr ModInt operator-(ModInt a, ModInt b) { return a -= b; }
+    friend constexpr ModInt operator*(ModInt a, ModInt b) { return a *= b; }
+    friend constexpr ModInt operator/(ModInt a, ModInt b) { return a /= b; }
+    friend constexpr bool operator==(ModInt a, ModInt b) { return a.value == b.value; }
+    friend constexpr bool operator!=(ModInt a, ModInt b) { return a.value != b.value; }
+
+    friend std::ostream& operator<<(std::ostream& out, ModInt x) { return out << x.get(); }
+
+  private:
+    uint32_t value;
+
+    static constexpr uint32_t computeNegatedInverse() {
+        // Newton iteration for P^-1 mod 2^32, each step doubles the number of correct bits
+        uint32_t inverse = P;
+        for (int i = 0; i < 4; ++i) inverse *= 2 - P * inverse;
+        return -inverse;
+    }
+
+    static constexpr uint32_t NEG_INV = computeNegatedInverse();
+    static constexpr uint32_t R2 = static_cast<uint32_t>(-static_cast<uint64_t>(P) % P); // 2^64 mod P
+
+    // t * 2^-32 mod P, for t < P * 2^32
+    static constexpr uint32_t reduce(uint64_t t) {
+        const uint32_t m = static_cast<uint32_t>(t) * NEG_INV;
+        const uint32_t result = static_cast<uint32_t>((t + static_cast<uint64_t>(m) * P) >> 32);
+        return result >= P ? result - P : result;
+    }
+
+    static constexpr long long normalize(long long x) {
+        x %= static_cast<long long>(P);
+        return x < 0 ? x + P : x;
+    }
+
+    static constexpr ModInt fromMontgomery(uint32_t montgomery) {
+        ModInt result;
+        result.value = montgomery;
+        return result;
+    }
+};
+
+template <uint32_t P>
+using ModPoly = BasicPoly<ModInt<P>>;
+
+// Number-theoretic transform for primes of the form c * 2^k + 1.
+template <uint32_t P>
+class Ntt
+{
+  public:
+    // largest power of two dividing P - 1, which bounds the transform length
+    static constexpr int TWO_ADICITY = [] {
+        int k = 0;
+        while (((P - 1) >> k) % 2 == 0) ++k;
+        return k;
+    }();
+
+    // transforms shorter than 2^MIN_TWO_ADICITY are not worth it, such primes use the schoolbook product
+    static constexpr int MIN_TWO_ADICITY = 16;
+
+    static constexpr uint32_t PRIMITIVE_ROOT = [] {
+        // collect the prime factors of P - 1
+        uint32_t factors[32] = {};
+        int factorCount = 0;
+        uint32_t n = P - 1;
+        for (uint32_t d = 2; static_cast<uint64_t>(d) * d <= n; ++d) {
+            if (n % d != 0) continue;
+            factors[factorCount++] = d;
+            while (n % d == 0) n /= d;
+        }
+        if (n > 1) factors[factorCount++] = n;
+
+        for (uint32_t g = 2;; ++g) {
+            bool isGenerator = true;
+            for (int i = 0; i < factorCount && isGenerator; ++i) {
+                isGenerator = ModInt<P>(g).pow((P - 1) / factors[i]) != ModInt<P>(1);
+            }
+            if (isGenerator) return g;
+        }
+    }();
+
+    // In-place decimation-in-frequency transform: natural order in, bit-reversed order out.
+    // data.size() must be a power of two not above 2^TWO_ADICITY.
+    static void forward(std::vector<ModInt<P>>& data) {
+        const size_t n = data.size();
+        std::vector<ModInt<P>> twiddles(n / 2);
+        for (size_t length = n; length >= 2; length >>= 1) {
+            const size_t half = length / 2;
+            computeTwiddles(twiddles, length, ModInt<P>(PRIMITIVE_ROOT).pow((P - 1) / length));
+            for (size_t start = 0; start < n; start += length) {
+                for (size_t k = 0; k < half; ++k) {
+                    const ModInt<P> u = data[start + k];
+                    const ModInt<P> v = data[start + k + half];
+                    data[start + k] = u + v;
+                    data[start + k + half] = (u - v) * twiddles[k];
+                }
+            }
+        }
+    }
+
+    // Inverse of forward(): bit-reversed order in, natural order out, scaled by 1/n.
+    static void inverse(std::vector<ModInt<P>>& data) {
+        const size_t n = data.size();
+        std::vector<ModInt<P>> twiddles(n / 2);
+        for (size_t length = 2; length <= n; length <<= 1) {
+            const size_t half = length / 2;
+            computeTwiddles(twiddles, length, ModInt<P>(PRIMITIVE_ROOT).pow((P - 1) / length).inverse());
+            for (size_t start = 0; start < n; start += length) {
+                for (size_t k = 0; k < half; ++k) {
+                    const ModInt<P> u = data[start + k];
+                    const ModInt<P> v = data[start + k + half] * twiddles[k];
+                    data[start + k] = u + v;
+                    data[start + k + half] = u - v;
+                }
+            }
+        }
+
+        const ModInt<P> scale = ModInt<P>(static_cast<long long>(n)).inverse();
+        for (auto& x : data) x *= scale;
+    }
+
+    // log2 of the cyclic convolution length for a product with resultSize coefficients. Length n is enough for
+    // n + 1 coefficients: only the top one wraps around onto the constant term, and it is known in advance.
+    static int productLog2(size_t resultSize) {
+        int log2n = 0;
+        while ((size_t(1) << log2n) + 1 < resultSize) ++log2n;
+        return log2n;
+    }
+
+    // Product of two polynomials folded into cyclic sequences of length n = 2^productLog2(resultSize), with
+    // top the product of their leading coefficients. a receives the resultSize coefficients, b is clobbered.
+    static void multiply(std::vector<ModInt<P>>& a, std::vector<ModInt<P>>& b, ModInt<P> top, size_t resultSize) {
+        const size_t n = a.size();
+        forward(a);
+        forward(b);
+        for (size_t i = 0; i < n; ++i) a[i] *= b[i];
+        inverse(a);
+        if (resultSize > n) {
+            a[0] -= top;
+            a.push_back(top);
+        }
+        a.resize(resultSize);
+    }
+
+  private:
+    static void computeTwiddles(std::vector<ModInt<P>>& twiddles, size_t length, ModInt<P> root) {
+        twiddles[0] = 1;
+        for (size_t k = 1; k < length / 2; ++k) twiddles[k] = twiddles[k - 1] * root;
+    }
+};
+
+// Dense products over NTT-friendly primes go through the transform instead of the schoolbook loop.
+template <uint32_t P>
+struct PolyMultiplication<ModInt<P>>
+{
+    static bool multiply(const std::map<int, ModInt<P>>& a, const std::map<int, ModInt<P>>& b,
+                         std::map<int, ModInt<P>>& product) {
+        if (Ntt<P>::TWO_ADICITY < Ntt<P>::MIN_TWO_ADICITY || a.empty() || b.empty()) return false;
+
+        const size_t resultSize = static_cast<size_t>(a.rbegin()->first) + b.rbegin()->first + 1;
+        const int log2n = Ntt<P>::productLog2(resultSize);
+        if (log2n > Ntt<P>::TWO_ADICITY) return false;
+        const size_t n = size_t(1) << log2n;
+
+        // sparse operands are cheaper to multiply term by term
+        const double schoolbookCost = static_cast<double>(a.size()) * b.size();
+        if (schoolbookCost <= 4.0 * n * (log2n + 1)) return false;
+
+        std::vector<ModInt<P>> fa(n), fb(n);
+        for (const auto& term : a) fa[term.first % n] += term.second;
+        for (const auto& term : b) fb[term.first % n] += term.second;
+        Ntt<P>::multiply(fa, fb, a.rbegin()->second * b.rbegin()->second, resultSize);
+        for (size_t i = 0; i < resultSize; ++i) {
+            if (fa[i] != ModInt<P>()) product.emplace_hint(product.end(), static_cast<int>(i), fa[i]);
+        }
+        return true;
+    }
+};
+
+// Product of two dense coefficient vectors, a[i] being the coefficient of x^i, through the NTT. Skips the term
+// map, whose fill and read cost more than the transforms for large products. Throws std::length_error when
+// the product needs a longer transform than P supports.
+template <uint32_t P>
+std::vector<ModInt<P>> nttMultiply(const std::vector<ModInt<P>>& a, const std::vector<ModInt<P>>& b) {
+    if (a.empty() || b.empty()) return {};
+
+    const size_t resultSize = a.size() + b.size() - 1;
+    const int log2n = Ntt<P>::productLog2(resultSize);
+    if (log2n > Ntt<P>::TWO_ADICITY) {
+        throw std::length_error("product is too long for the number-theoretic transform modulo P");
+    }
+    const size_t n = size_t(1) << log2n;
+
+    std::vector<ModInt<P>> fa(n), fb(n);
+    for (size_t i = 0; i < a.size(); ++i) fa[i % n] += a[i];
+    for (size_t i = 0; i < b.size(); ++i) fb[i % n] += b[i];
+    Ntt<P>::multiply(fa, fb, a.back() * b.back(), resultSize);
+    return fa;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// Sparse polynomial in a fixed number of variables x1..xn.
+// Each monomial is packed into one 64-bit key: the total degree in the most significant field, followed by
+// the exponents of x1..xn. Comparing keys therefore gives the graded lexicographic order, and multiplying
+// monomials is adding keys. Terms are kept in a vector sorted from the leading (largest) monomial down.
+class MultiPoly
+{
+  public:
+    static constexpr int MAX_VARIABLES = 15;
+
+    explicit MultiPoly(int variables, double value = 0.0);
+    // the polynomial x_index, for 1 <= index <= variables
+    static MultiPoly variable(int variables, int index);
+
+    int variables() const { return variableCount; }
+    size_t termCount() const { return terms.size(); }
+    int totalDegree() const;
+    // largest exponent the packing can hold in one field, which also bounds the total degree
+    int maxDegree() const;
+
+    double operator[](const std::vector<int>& exponents) const;
+    void setCoefficient(const std::vector<int>& exponents, double coefficient);
+
+    MultiPoly operator-() const;
+
+    MultiPoly& operator+=(const MultiPoly& p2);
+    MultiPoly& operator-=(const MultiPoly& p2);
+    MultiPoly& operator*=(const MultiPoly& p2);
+
+    double operator()(const std::vector<double>& point) const;
+    // Evaluates at count points given in structure-of-arrays layout: coordinate v of point k is
+    // points[v * count + k]. Writes count values to out.
+    void evaluate(const double* points, size_t count, double* out) const;
+
+    friend bool operator==(const MultiPoly& p1, const MultiPoly& p2);
+    friend std::ostream& operator<<(std::ostream& out, const MultiPoly& p);
+
+  private:
+    struct Term
+    {
+        uint64_t monomial;
+        double coefficient;
+    };
+
+    int variableCount;
+    int fieldBits;
+    std::vector<Term> terms;
+
+    uint64_t pack(const std::vector<int>& exponents) const;
+    int exponentOf(uint64_t monomial, int variable) const;
+    int degreeOf(uint64_t monomial) const;
+    uint64_t fieldMask() const { return (uint64_t(1) << fieldBits) - 1; }
+    void throwIfVariablesMismatch(const MultiPoly& other) const;
+    void addScaled(const MultiPoly& p2, double alpha);
+};
+
+MultiPoly operator+(MultiPoly p1, const MultiPoly& p2);
+MultiPoly operator-(MultiPoly p1, const MultiPoly& p2);
+MultiPoly operator*(MultiPoly p1, const MultiPoly& p2);
+
+bool operator!=(const MultiPoly& p1, const MultiPoly& p2);
@@ -1,34 +1,35 @@
 #pragma once
+#include "BasicPoly.h"
+#include <charconv>
+#include <complex>
 #include <iosfwd>
-#include <map>
-
-class Poly
-{
-  public:
-    Poly(double value = 0.0);
-    Poly(const std::map<int, double>& newTerms);
-
-    Poly operator-() const;
-
-    Poly& operator+=(const Poly& p2);
-    Poly& operator-=(const Poly& p2);
-    Poly& operator*=(const Poly& p2);
-
-    double operator[](int exponent) const;
-    double& operator[](int exponent);
-    double operator()(double value) const;
-  private:
-    std::map<int, double> terms;
-    void removeZeros();
-    const std::map<int, double>& getTerms() const;
-    friend bool operator==(const Poly& p1, const Poly& p2);
-    friend std::ostream& operator<<(std::ostream& out, const Poly& p);
-};
-
-Poly operator+(Poly p1, const Poly& p2);
-Poly operator-(Poly p1, const Poly& p2);
-Poly operator*(Poly p1, const Poly& p2);
-
-bool operator!=(const Poly& p1, const Poly& p2);
-
-
+#include <string_view>
+#include <vector>
+
+using Poly = BasicPoly<double>;
+
+// Members that exist only for double coefficients, defined in PolyFormat.cpp and PolyRoots.cpp
+template <>
+std::vector<std::complex<double>> Poly::roots() const;
+template <>
+std::vector<double> Poly::realRoots(double tolerance) const;
+template <>
+std::from_chars_result Poly::fromChars(const char* first, const char* last, Poly& result);
+template <>
+Poly Poly::parse(std::string_view text);
+template <>
+std::to_chars_result Poly::toChars(char* first, char* last) const;
+template <>
+void Poly::serialize(std::vector<unsigned char>& out) const;
+template <>
+const unsigned char* Poly::deserialize(const unsigned char* first, const unsigned char* last, Poly& result);
+template <>
+std::to_chars_result Poly::formatTerm(char* first, char* last, int exponent, double coefficient, bool leading,
+                                      int precision, std::ios_base::fmtflags flags);
+template <>
+std::ostream& Poly::write(std::ostream& out) const;
+
+// Poly is instantiated once, in Poly.cpp
+extern template class BasicPoly<double>;
+
+std::vector<std::vector<double>> realRoots(const std::vector<Poly>& polys, double tolerance = 1e-7);
@@ -0,0 +1,326 @@
+#include "MultiPoly.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// number of points evaluated together, so the power tables of one block stay in cache
+static constexpr size_t EVALUATION_BLOCK = 256;
+// exponents up to this are looked up in the per-block power tables, larger ones are computed per term by
+// repeated squaring, so a single high-degree term does not need a table with one row per power
+static constexpr int MAX_TABULATED_EXPONENT = 64;
+
+MultiPoly::MultiPoly(int variables, double value) : variableCount(variables) {
+    if (variables < 1 || variables > MAX_VARIABLES) {
+        throw std::invalid_argument("number of variables must be between 1 and " + std::to_string(MAX_VARIABLES));
+    }
+    fieldBits = 64 / (variables + 1);
+    if (value != 0.0) {
+        terms.push_back({0, value});
+    }
+}
+
+MultiPoly MultiPoly::variable(int variables, int index) {
+    MultiPoly result(variables);
+    if (index < 1 || index > variables) {
+        throw std::invalid_argument("variable index out of range");
+    }
+    std::vector<int> exponents(variables, 0);
+    exponents[index - 1] = 1;
+    result.setCoefficient(exponents, 1.0);
+    return result;
+}
+
+int MultiPoly::totalDegree() const { return terms.empty() ? 0 : degreeOf(terms.front().monomial); }
+
+int MultiPoly::maxDegree() const { return static_cast<int>(std::min<uint64_t>(fieldMask(), INT_MAX)); }
+
+uint64_t MultiPoly::pack(const std::vector<int>& exponents) const {
+    if (static_cast<int>(exponents.size()) != variableCount) {
+        throw std::invalid_argument("expected one exponent per variable");
+    }
+    uint64_t monomial = 0;
+    long long degree = 0;
+    for (int exponent : exponents) {
+        if (exponent < 0) {
+            throw std::invalid_argument("only non-negative exponents are allowed");
+        }
+        degree += exponent;
+        monomial = (monomial << fieldBits) | static_cast<uint64_t>(exponent);
+    }
+    if (degree > maxDegree()) {
+        throw std::overflow_error("total degree too large for " + std::to_string(variableCount) + " variables");
+    }
+    return monomial | static_cast<uint64_t>(degree) << (variableCount * fieldBits);
+}
+
+int MultiPoly::exponentOf(uint64_t monomial, int variable) const {
+    return static_cast<int>((monomial >> ((variableCount - 1 - variable) * fieldBits)) & fieldMask());
+}
+
+int MultiPoly::degreeOf(uint64_t monomial) const {
+    return static_cast<int>((monomial >> (variableCount * fieldBits)) & fieldMask());
+}
+
+void MultiPoly::throwIfVariablesMismatch(const MultiPoly& other) const {
+    if (variableCount != other.variableCount) {
+        throw std::invalid_argument("polynomials must have the same number of variables");
+    }
+}
+
+static bool leadsBefore(uint64_t monomial1, uint64_t monomial2) { return monomial1 > monomial2; }
+
+double MultiPoly::operator[](const std::vector<int>& exponents) const {
+    const uint64_t monomial = pack(exponents);
+    auto it = std::lower_bound(terms.begin(), terms.end(), monomial,
+                               [](const Term& term, uint64_t m) { return leadsBefore(term.monomial, m); });
+    return it != terms.end() && it->monomial == monomial ? it->coefficient : 0.0;
+}
+
+void MultiPoly::setCoefficient(const std::vector<int>& exponents, double coefficient) {
+    const uint64_t monomial = pack(exponents);
+    auto it = std::lower_bound(terms.begin(), terms.end(), monomial,
+                               [](const Term& term, uint64_t m) { return leadsBefore(term.monomial, m); });
+    const bool exists = it != terms.end() && it->monomial == monomial;
+    if (coefficient == 0.0) {
+        if (exists) terms.erase(it);
+    }
+    else if (exists) {
+        it->coefficient = coefficient;
+    }
+    else {
+        terms.insert(it, {monomial, coefficient});
+    }
+}
+
+MultiPoly MultiPoly::operator-() const {
+    MultiPoly result = *this;
+    for (auto& term : result.terms) {
+        term.coefficient = -term.coefficient;
+    }
+    return result;
+}
+
+void MultiPoly::addScaled(const MultiPoly& p2, double alpha) {
+    throwIfVariablesMismatch(p2);
+
+    // merge of two sorted term lists
+    std::vector<Term> sum;
+    sum.reserve(terms.size() + p2.terms.size());
+    auto it1 = terms.begin();
+    auto it2 = p2.terms.begin();
+    while (it1 != terms.end() || it2 != p2.terms.end()) {
+        if (it2 == p2.terms.end() || (it1 != terms.end() && leadsBefore(it1->monomial, it2->monomial))) {
+            sum.push_back(*it1++);
+        }
+        else if (it1 == terms.end() || leadsBefore(it2->monomial, it1->monomial)) {
+            sum.push_back({it2->monomial, alpha * it2->coefficient});
+            ++it2;
+        }
+        else {
+            const double coefficient = it1->coefficient + alpha * it2->coefficient;
+            if (coefficient != 0.0) sum.push_back({it1->monomial, coefficient});
+            ++it1;
+            ++it2;
+        }
+    }
+    terms.swap(sum);
+}
+
+MultiPoly& MultiPoly::operator+=(const MultiPoly& p2) {
+    addScaled(p2, 1.0);
+    return *this;
+}
+
+MultiPoly& MultiPoly::operator-=(const MultiPoly& p2) {
+    addScaled(p2, -1.0);
+    return *this;
+}
+
+MultiPoly& MultiPoly::operator*=(const MultiPoly& p2) {
+    throwIfVariablesMismatch(p2);
+    if (terms.empty() || p2.terms.empty()) {
+        terms.clear();
+        return *this;
+    }
+    if (static_cast<long long>(totalDegree()) + p2.totalDegree() > maxDegree()) {
+        throw std::overflow_error("total degree of the product too large for " + std::to_string(variableCount) +
+                                  " variables");
+    }
+
+    // Heap merge of the rows a[i] * b: the heap holds the next unmerged product of each started row,
+    // so the product terms come out already sorted and equal monomials arrive consecutively.
+    const std::vector<Term>& a = terms.size() <= p2.terms.size() ? terms : p2.terms;
+    const std::vector<Term>& b = &a == &terms ? p2.terms : terms;
+
+    struct Entry
+    {
+        uint64_t monomial;
+        size_t row;
+        size_t column;
+    };
+    auto lowerPriority = [](const Entry& e1, const Entry& e2) { return e1.monomial < e2.monomial; };
+
+    std::vector<Entry> heap;
+    heap.reserve(a.size());
+    heap.push_back({a[0].monomial + b[0].monomial, 0, 0});
+
+    std::vector<Term> product;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), lowerPriority);
+        const Entry top = heap.back();
+        heap.pop_back();
+
+        const double coefficient = a[top.row].coefficient * b[top.column].coefficient;
+        if (!product.empty() && product.back().monomial == top.monomial) {
+            product.back().coefficient += coefficient;
+        }
+        else {
+            if (!product.empty() && product.back().coefficient == 0.0) product.pop_back();
+            product.push_back({top.monomial, coefficient});
+        }
+
+        // rows are started lazily: row i + 1 cannot lead before row i has produced its first term
+        if (top.column == 0 && top.row + 1 < a.size()) {
+            heap.push_back({a[top.row + 1].monomial + b[0].monomial, top.row + 1, 0});
+            std::push_heap(heap.begin(), heap.end(), lowerPriority);
+        }
+        if (top.column + 1 < b.size()) {
+            heap.push_back({a[top.row].monomial + b[top.column + 1].monomial, top.row, top.column + 1});
+            std::push_heap(heap.begin(), heap.end(), lowerPriority);
+        }
+    }
+    if (!product.empty() && product.back().coefficient == 0.0) product.pop_back();
+
+    terms.swap(product);
+    return *this;
+}
+
+double MultiPoly::operator()(const std::vector<double>& point) const {
+    if (static_cast<int>(point.size()) != variableCount) {
+        throw std::invalid_argument("expected one coordinate per variable");
+    }
+    // a single point in structure-of-arrays layout is just the coordinate list
+    double result;
+    evaluate(point.data(), 1, &result);
+    return result;
+}
+
+void MultiPoly::evaluate(const double* points, size_t count, double* out) const {
+    std::vector<int> maxExponent(variableCount, 0);
+    for (const auto& term : terms) {
+        for (int v = 0; v < variableCount; ++v) {
+            maxExponent[v] = std::max(maxExponent[v], std::min(exponentOf(term.monomial, v), MAX_TABULATED_EXPONENT));
+        }
+    }
+
+    // powers[tableOffset[v] + e * EVALUATION_BLOCK + k] == x_v^e at point k of the current block
+    std::vector<size_t> tableOffset(variableCount + 1, 0);
+    for (int v = 0; v < variableCount; ++v) {
+        tableOffset[v + 1] = tableOffset[v] + (maxExponent[v] + 1) * EVALUATION_BLOCK;
+    }
+    std::vector<double> powers(tableOffset[variableCount]);
+    std::vector<double> termValue(EVALUATION_BLOCK), base(EVALUATION_BLOCK);
+
+    for (size_t first = 0; first < count; first += EVALUATION_BLOCK) {
+        const size_t n = std::min(EVALUATION_BLOCK, count - first);
+
+        for (int v = 0; v < variableCount; ++v) {
+            double* table = powers.data() + tableOffset[v];
+            const double* x = points + v * count + first;
+            for (size_t k = 0; k < n; ++k) table[k] = 1.0;
+            for (int e = 1; e <= maxExponent[v]; ++e) {
+                const double* previous = table + (e - 1) * EVALUATION_BLOCK;
+                double* current = table + e * EVALUATION_BLOCK;
+                for (size_t k = 0; k < n; ++k) current[k] = previous[k] * x[k];
+            }
+        }
+
+        double* result = out + first;
+        for (size_t k = 0; k < n; ++k) result[k] = 0.0;
+        for (const auto& term : terms) {
+            for (size_t k = 0; k < n; ++k) termValue[k] = term.coefficient;
+            for (int v = 0; v < variableCount; ++v) {
+                int e = exponentOf(term.monomial, v);
+                if (e == 0) continue;
+                if (e <= MAX_TABULATED_EXPONENT) {
+                    const double* power = powers.data() + tableOffset[v] + e * EVALUATION_BLOCK;
+                    for (size_t k = 0; k < n; ++k) termValue[k] *= power[k];
+                    continue;
+                }
+                const double* x = points + v * count + first;
+                for (size_t k = 0; k < n; ++k) base[k] = x[k];
+                while (true) {
+                    if (e & 1) {
+                        for (size_t k = 0; k < n; ++k) termValue[k] *= base[k];
+                    }
+                    e >>= 1;
+                    if (e == 0) break;
+                    for (size_t k = 0; k < n; ++k) base[k] *= base[k];
+                }
+            }
+            for (size_t k = 0; k < n; ++k) result[k] += termValue[k];
+        }
+    }
+}
+
+MultiPoly operator+(MultiPoly p1, const MultiPoly& p2) {
+    p1 += p2;
+    return p1;
+}
+
+MultiPoly operator-(MultiPoly p1, const MultiPoly& p2) {
+    p1 -= p2;
+    return p1;
+}
+
+MultiPoly operator*(MultiPoly p1, const MultiPoly& p2) {
+    p1 *= p2;
+    return p1;
+}
+
+bool operator==(const MultiPoly& p1, const MultiPoly& p2) {
+    return p1.variableCount == p2.variableCount &&
+           std::equal(p1.terms.begin(), p1.terms.end(), p2.terms.begin(), p2.terms.end(),
+                      [](const MultiPoly::Term& t1, const MultiPoly::Term& t2) {
+                          return t1.monomial == t2.monomial && t1.coefficient == t2.coefficient;
+                      });
+}
+
+bool operator!=(const MultiPoly& p1, const MultiPoly& p2) { return !(p1 == p2); }
+
+std::ostream& operator<<(std::ostream& out, const MultiPoly& p) {
+    if (p.terms.empty()) return out << "0";
+
+    bool first = true;
+    for (const auto& term : p.terms) {
+        double coefficient = term.coefficient;
+
+        // sign
+        if (!first)
+            out << (coefficient > 0 ? " + " : " - ");
+        else if (coefficient < 0)
+            out << "-";
+
+        coefficient = std::abs(coefficient);
+        first = false;
+
+        if (term.monomial == 0 || coefficient != 1.0) {
+            if (coefficient <= INT_MAX && coefficient == static_cast<int>(coefficient))
+                out << static_cast<int>(coefficient);
+            else
+                out << coefficient;
+        }
+
+        for (int v = 0; v < p.variableCount; ++v) {
+            const int exponent = p.exponentOf(term.monomial, v);
+            if (exponent == 0) continue;
+            out << "x" << v + 1;
+            if (exponent > 1) out << "^" << exponent;
+        }
+    }
+    return out;
+}
@@ -0,0 +1,277 @@
+#include "Poly.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+static std::to_chars_result appendText(char* first, char* last, std::string_view text) {
+    if (last - first < static_cast<std::ptrdiff_t>(text.size())) return {last, std::errc::value_too_large};
+    std::memcpy(first, text.data(), text.size());
+    return {first + text.size(), std::errc()};
+}
+
+static constexpr double POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10};
+
+// Coefficients follow the floatfield and uppercase flags and the precision like stream insertion of a double.
+template <>
+std::to_chars_result Poly::formatTerm(char* first, char* last, int exponent, double coefficient, bool leading,
+                                      int precision, std::ios_base::fmtflags flags) {
+    std::to_chars_result result{first, std::errc()};
+    if (coefficient == 0.0) return result;
+
+    // sign
+    if (!leading)
+        result = appendText(result.ptr, last, coefficient > 0 ? " + " : " - ");
+    else if (coefficient < 0)
+        result = appendText(result.ptr, last, "-");
+    if (result.ec != std::errc()) return result;
+
+    coefficient = std::abs(coefficient);
+
+    // coefficient
+    if (exponent == 0 || coefficient != 1.0) {
+        char* const digits = result.ptr;
+        switch (flags & std::ios_base::floatfield) {
+        case std::ios_base::fixed:
+            result = std::to_chars(result.ptr, last, coefficient, std::chars_format::fixed, precision);
+            break;
+        case std::ios_base::scientific:
+            result = std::to_chars(result.ptr, last, coefficient, std::chars_format::scientific, precision);
+            break;
+        case std::ios_base::fixed | std::ios_base::scientific:
+            result = appendText(result.ptr, last, "0x");
+            if (result.ec == std::errc()) result = std::to_chars(result.ptr, last, coefficient, std::chars_format::hex);
+            break;
+        default:
+            // integers with at most precision digits print the same either way, and int is quicker to format
+            if (coefficient <= INT_MAX && coefficient == static_cast<int>(coefficient) &&
+                coefficient < POWERS_OF_TEN[std::clamp(precision, 1, 10)])
+                result = std::to_chars(result.ptr, last, static_cast<int>(coefficient));
+            else
+                result = std::to_chars(result.ptr, last, coefficient, std::chars_format::general, precision);
+        }
+        if (result.ec != std::errc()) return result;
+        if (flags & std::ios_base::uppercase) {
+            for (char* c = digits; c != result.ptr; ++c) *c = static_cast<char>(std::toupper(*c));
+        }
+    }
+
+    // exponent
+    if (exponent != 0) {
+        result = appendText(result.ptr, last, "x");
+        if (result.ec == std::errc() && exponent > 1) {
+            result = appendText(result.ptr, last, "^");
+            if (result.ec == std::errc()) result = std::to_chars(result.ptr, last, exponent);
+        }
+    }
+    return result;
+}
+
+template <>
+std::to_chars_result Poly::toChars(char* first, char* last) const {
+    std::to_chars_result result{first, std::errc()};
+    bool leading = true;
+    for (auto it = terms.rbegin(); it != terms.rend(); ++it) {
+        if (it->second == 0.0) continue;
+        // the format of a default-constructed stream
+        result = formatTerm(result.ptr, last, it->first, it->second, leading, 6, std::ios_base::fmtflags());
+        if (result.ec != std::errc()) return result;
+        leading = false;
+    }
+    if (leading) result = appendText(first, last, "0");
+    return result;
+}
+
+template <>
+std::ostream& Poly::write(std::ostream& out) const {
+    char buffer[64];
+    std::vector<char> largeBuffer; // for terms such as std::fixed 1e300 or a large precision
+    const int precision = static_cast<int>(out.precision());
+    bool leading = true;
+    for (auto it = terms.rbegin(); it != terms.rend(); ++it) {
+        if (it->second == 0.0) continue;
+        auto result =
+            formatTerm(buffer, buffer + sizeof(buffer), it->first, it->second, leading, precision, out.flags());
+        if (result.ec == std::errc()) {
+            out.write(buffer, result.ptr - buffer);
+        }
+        else {
+            for (size_t size = 512; result.ec != std::errc(); size *= 2) {
+                largeBuffer.resize(size);
+                result = formatTerm(largeBuffer.data(), largeBuffer.data() + size, it->first, it->second, leading,
+                                    precision, out.flags());
+            }
+            out.write(largeBuffer.data(), result.ptr - largeBuffer.data());
+        }
+        leading = false;
+    }
+    if (leading) out << "0";
+    return out;
+}
+
+static const char* skipSpaces(const char* first, const char* last) {
+    while (first != last && (*first == ' ' || *first == '\t')) ++first;
+    return first;
+}
+
+template <>
+std::from_chars_result Poly::fromChars(const char* first, const char* last, Poly& result) {
+    const std::from_chars_result invalid{first, std::errc::invalid_argument};
+    std::map<int, double> parsed;
+
+    const char* ptr = skipSpaces(first, last);
+    bool negative = false;
+    if (ptr != last && *ptr == '-') {
+        negative = true;
+        ptr = skipSpaces(ptr + 1, last);
+    }
+
+    while (true) {
+        // coefficient, implicitly 1 when the term starts with x
+        double coefficient = 1.0;
+        bool hasCoefficient = false;
+        if (ptr != last && *ptr != 'x') {
+            const auto number = std::from_chars(ptr, last, coefficient);
+            if (number.ec != std::errc()) return invalid;
+            ptr = number.ptr;
+            hasCoefficient = true;
+        }
+
+        int exponent = 0;
+        if (ptr != last && *ptr == 'x') {
+            ++ptr;
+            exponent = 1;
+            if (ptr != last && *ptr == '^') {
+                const auto number = std::from_chars(ptr + 1, last, exponent);
+                if (number.ec != std::errc() || exponent < 0) return invalid;
+                ptr = number.ptr;
+            }
+        }
+        else if (!hasCoefficient) {
+            return invalid;
+        }
+        parsed[exponent] += negative ? -coefficient : coefficient;
+
+        // separator before the next term
+        const char* next = skipSpaces(ptr, last);
+        if (next == last || (*next != '+' && *next != '-')) break;
+        negative = *next == '-';
+        ptr = skipSpaces(next + 1, last);
+    }
+
+    result.terms.swap(parsed);
+    result.removeZeros();
+    return {ptr, std::errc()};
+}
+
+template <>
+Poly Poly::parse(std::string_view text) {
+    Poly result;
+    const char* last = text.data() + text.size();
+    const auto parsed = fromChars(text.data(), last, result);
+    if (parsed.ec != std::errc() || skipSpaces(parsed.ptr, last) != last) {
+        throw std::invalid_argument("invalid polynomial: " + std::string(text));
+    }
+    return result;
+}
+
+static void writeVarint(std::vector<unsigned char>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+static const unsigned char* readVarint(const unsigned char* first, const unsigned char* last, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (first == last) throw std::invalid_argument("truncated polynomial data");
+        const unsigned char byte = *first++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return first;
+    }
+    throw std::invalid_argument("malformed varint in polynomial data");
+}
+
+// integer coefficients in this range are stored as zigzag varints instead of 8 raw bytes
+static constexpr double MAX_PACKED_INTEGER = 9007199254740992.0; // 2^53
+
+template <>
+void Poly::serialize(std::vector<unsigned char>& out) const {
+    size_t count = 0;
+    for (const auto& term : terms) {
+        if (term.second != 0.0) ++count;
+    }
+    writeVarint(out, count);
+
+    int previousExponent = 0;
+    for (const auto& term : terms) {
+        if (term.second == 0.0) continue;
+
+        const double coefficient = term.second;
+        const bool isInteger = std::fabs(coefficient) <= MAX_PACKED_INTEGER && coefficient == std::trunc(coefficient);
+        const uint64_t delta = static_cast<uint64_t>(term.first - previousExponent);
+        writeVarint(out, delta << 1 | (isInteger ? 1 : 0));
+        previousExponent = term.first;
+
+        if (isInteger) {
+            const auto value = static_cast<int64_t>(coefficient);
+            writeVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+        else {
+            uint64_t bits;
+            std::memcpy(&bits, &coefficient, sizeof(bits));
+            for (int i = 0; i < 8; ++i) {
+                out.push_back(static_cast<unsigned char>(bits >> (8 * i)));
+            }
+        }
+    }
+}
+
+template <>
+const unsigned char* Poly::deserialize(const unsigned char* first, const unsigned char* last, Poly& result) {
+    uint64_t count;
+    first = readVarint(first, last, count);
+
+    std::map<int, double> decoded;
+    uint64_t exponent = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t header;
+        first = readVarint(first, last, header);
+        exponent += header >> 1;
+        if (exponent > INT_MAX || (i > 0 && (header >> 1) == 0)) {
+            throw std::invalid_argument("invalid exponent in polynomial data");
+        }
+
+        double coefficient;
+        if (header & 1) {
+            uint64_t zigzag;
+            first = readVarint(first, last, zigzag);
+            coefficient = static_cast<double>(static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1));
+        }
+        else {
+            if (last - first < 8) throw std::invalid_argument("truncated polynomial data");
+            uint64_t bits = 0;
+            for (int b = 0; b < 8; ++b) {
+                bits |= static_cast<uint64_t>(first[b]) << (8 * b);
+            }
+            first += 8;
+            std::memcpy(&coefficient, &bits, sizeof(coefficient));
+        }
+        decoded.emplace_hint(decoded.end(), static_cast<int>(exponent), coefficient);
+    }
+
+    result.terms.swap(decoded);
+    result.removeZeros();
+    return first;
+}
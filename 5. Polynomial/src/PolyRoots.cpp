@@ -0,0 +1,255 @@
+#include "Matrix.h"
+#include "Poly.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+// Up to this degree roots are the eigenvalues of the companion matrix, above it Aberth-Ehrlich is used.
+static constexpr size_t COMPANION_MAX_DEGREE = 32;
+static constexpr int MAX_QR_ITERATIONS = 60;
+static constexpr int MAX_ABERTH_ITERATIONS = 500;
+
+// Eigenvalues of an upper Hessenberg matrix using Francis double-shift QR iterations.
+// The matrix is overwritten.
+static std::vector<std::complex<double>> hessenbergEigenvalues(Matrix& a) {
+    const Matrix& h = a;
+    const int n = static_cast<int>(a.getRows());
+    std::vector<std::complex<double>> eigenvalues(n);
+
+    double norm = 0.0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = std::max(i - 1, 0); j < n; ++j) {
+            norm += std::fabs(h(i, j));
+        }
+    }
+
+    int nn = n - 1;
+    int l = 0;
+    double shift = 0.0;
+    while (nn >= 0) {
+        int iterations = 0;
+        do {
+            // look for a negligible subdiagonal element to split the matrix
+            for (l = nn; l >= 1; --l) {
+                double s = std::fabs(h(l - 1, l - 1)) + std::fabs(h(l, l));
+                if (s == 0.0) s = norm;
+                if (std::fabs(h(l, l - 1)) + s == s) {
+                    a(l, l - 1) = 0.0;
+                    break;
+                }
+            }
+
+            double x = h(nn, nn);
+            if (l == nn) {
+                eigenvalues[nn--] = x + shift;
+                continue;
+            }
+
+            double y = h(nn - 1, nn - 1);
+            double w = h(nn, nn - 1) * h(nn - 1, nn);
+            if (l == nn - 1) {
+                const double p = 0.5 * (y - x);
+                const double q = p * p + w;
+                double z = std::sqrt(std::fabs(q));
+                x += shift;
+                if (q >= 0.0) {
+                    z = p + std::copysign(z, p);
+                    eigenvalues[nn - 1] = x + z;
+                    eigenvalues[nn] = z != 0.0 ? x - w / z : x + z;
+                }
+                else {
+                    eigenvalues[nn - 1] = std::complex<double>(x + p, -z);
+                    eigenvalues[nn] = std::complex<double>(x + p, z);
+                }
+                nn -= 2;
+                continue;
+            }
+
+            if (iterations == MAX_QR_ITERATIONS) {
+                throw std::runtime_error("eigenvalue iteration did not converge");
+            }
+            if (iterations == 10 || iterations == 20) {
+                // exceptional shift
+                shift += x;
+                for (int i = 0; i <= nn; ++i) a(i, i) = h(i, i) - x;
+                const double s = std::fabs(h(nn, nn - 1)) + std::fabs(h(nn - 1, nn - 2));
+                y = x = 0.75 * s;
+                w = -0.4375 * s * s;
+            }
+            ++iterations;
+
+            // find two consecutive small subdiagonal elements
+            int m = nn - 2;
+            double p = 0.0, q = 0.0, r = 0.0, z = 0.0;
+            for (; m >= l; --m) {
+                z = h(m, m);
+                r = x - z;
+                double s = y - z;
+                p = (r * s - w) / h(m + 1, m) + h(m, m + 1);
+                q = h(m + 1, m + 1) - z - r - s;
+                r = h(m + 2, m + 1);
+                s = std::fabs(p) + std::fabs(q) + std::fabs(r);
+                p /= s;
+                q /= s;
+                r /= s;
+                if (m == l) break;
+                const double u = std::fabs(h(m, m - 1)) * (std::fabs(q) + std::fabs(r));
+                const double v = std::fabs(p) * (std::fabs(h(m - 1, m - 1)) + std::fabs(z) + std::fabs(h(m + 1, m + 1)));
+                if (u + v == v) break;
+            }
+            for (int i = m; i < nn - 1; ++i) {
+                a(i + 2, i) = 0.0;
+                if (i != m) a(i + 2, i - 1) = 0.0;
+            }
+
+            // double QR step on rows l..nn and columns m..nn
+            for (int k = m; k < nn; ++k) {
+                if (k != m) {
+                    p = h(k, k - 1);
+                    q = h(k + 1, k - 1);
+                    r = k + 1 != nn ? h(k + 2, k - 1) : 0.0;
+                    x = std::fabs(p) + std::fabs(q) + std::fabs(r);
+                    if (x != 0.0) {
+                        p /= x;
+                        q /= x;
+                        r /= x;
+                    }
+                }
+                const double s = std::copysign(std::sqrt(p * p + q * q + r * r), p);
+                if (s == 0.0) continue;
+
+                if (k == m) {
+                    if (l != m) a(k, k - 1) = -h(k, k - 1);
+                }
+                else {
+                    a(k, k - 1) = -s * x;
+                }
+                p += s;
+                x = p / s;
+                y = q / s;
+                z = r / s;
+                q /= p;
+                r /= p;
+                for (int j = k; j <= nn; ++j) {
+                    p = h(k, j) + q * h(k + 1, j);
+                    if (k + 1 != nn) {
+                        p += r * h(k + 2, j);
+                        a(k + 2, j) = h(k + 2, j) - p * z;
+                    }
+                    a(k + 1, j) = h(k + 1, j) - p * y;
+                    a(k, j) = h(k, j) - p * x;
+                }
+                const int lastRow = std::min(nn, k + 3);
+                for (int i = l; i <= lastRow; ++i) {
+                    p = x * h(i, k) + y * h(i, k + 1);
+                    if (k + 1 != nn) {
+                        p += z * h(i, k + 2);
+                        a(i, k + 2) = h(i, k + 2) - p * r;
+                    }
+                    a(i, k + 1) = h(i, k + 1) - p * q;
+                    a(i, k) = h(i, k) - p;
+                }
+            }
+        } while (l + 1 < nn);
+    }
+    return eigenvalues;
+}
+
+// coefficients[i] is the coefficient of x^i, the leading one is non-zero
+static std::vector<std::complex<double>> companionRoots(const std::vector<double>& coefficients) {
+    const size_t degree = coefficients.size() - 1;
+    Matrix companion(degree, degree);
+    for (size_t i = 1; i < degree; ++i) {
+        companion(i, i - 1) = 1.0;
+    }
+    for (size_t i = 0; i < degree; ++i) {
+        companion(i, degree - 1) = -coefficients[i] / coefficients[degree];
+    }
+    return hessenbergEigenvalues(companion);
+}
+
+static std::vector<std::complex<double>> aberthRoots(const std::vector<double>& coefficients) {
+    const size_t degree = coefficients.size() - 1;
+
+    // start on a circle whose radius is the geometric mean of the root magnitudes,
+    // rotated so that no starting point lies on the real axis
+    const double radius = std::pow(std::fabs(coefficients[0] / coefficients[degree]), 1.0 / degree);
+    const double pi = std::acos(-1.0);
+    std::vector<std::complex<double>> z(degree);
+    for (size_t k = 0; k < degree; ++k) {
+        z[k] = std::polar(radius, 2.0 * pi * k / degree + 0.4);
+    }
+
+    for (int iteration = 0; iteration < MAX_ABERTH_ITERATIONS; ++iteration) {
+        bool converged = true;
+        for (size_t k = 0; k < degree; ++k) {
+            std::complex<double> value = coefficients[degree];
+            std::complex<double> slope = 0.0;
+            for (size_t i = degree; i-- > 0;) {
+                slope = slope * z[k] + value;
+                value = value * z[k] + coefficients[i];
+            }
+            if (value == 0.0) continue;
+
+            const std::complex<double> newtonStep = value / slope;
+            std::complex<double> repulsion = 0.0;
+            for (size_t j = 0; j < degree; ++j) {
+                if (j != k) repulsion += 1.0 / (z[k] - z[j]);
+            }
+            const std::complex<double> step = newtonStep / (1.0 - newtonStep * repulsion);
+            z[k] -= step;
+            if (std::abs(step) > 1e-14 * std::max(1.0, std::abs(z[k]))) converged = false;
+        }
+        if (converged) break;
+    }
+    return z;
+}
+
+template <>
+std::vector<std::complex<double>> Poly::roots() const {
+    // the non-const operator[] can leave zero coefficients in terms, they must not count as the lowest or
+    // the leading term
+    const auto isNonZero = [](const auto& term) { return term.second != 0.0; };
+    const auto first = std::find_if(terms.begin(), terms.end(), isNonZero);
+    if (first == terms.end()) {
+        throw std::invalid_argument("zero polynomial has no finite set of roots");
+    }
+    const auto last = std::find_if(terms.rbegin(), terms.rend(), isNonZero);
+
+    // factor out x^lowest, its roots are all zero
+    const int lowest = first->first;
+    const size_t degree = last->first - lowest;
+    std::vector<std::complex<double>> result(lowest, 0.0);
+    if (degree == 0) return result;
+
+    std::vector<double> coefficients(degree + 1, 0.0);
+    for (auto it = first; it != last.base(); ++it) {
+        coefficients[it->first - lowest] = it->second;
+    }
+    const auto reduced = degree <= COMPANION_MAX_DEGREE ? companionRoots(coefficients) : aberthRoots(coefficients);
+    result.insert(result.end(), reduced.begin(), reduced.end());
+    return result;
+}
+
+template <>
+std::vector<double> Poly::realRoots(double tolerance) const {
+    std::vector<double> result;
+    for (const auto& root : roots()) {
+        if (std::fabs(root.imag()) <= tolerance * std::max(1.0, std::abs(root))) {
+            result.push_back(root.real());
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<std::vector<double>> realRoots(const std::vector<Poly>& polys, double tolerance) {
+    std::vector<std::vector<double>> result;
+    result.reserve(polys.size());
+    for (const auto& p : polys) {
+        result.push_back(p.realRoots(tolerance));
+    }
+    return result;
+}
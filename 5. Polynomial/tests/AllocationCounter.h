@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+
+// Number of global allocations so far. AllocationCounter.cpp replaces every form of the global operator new
+// and operator delete, in its own translation unit so no inlined delete is ever paired with a replaced new.
+size_t allocationCount();
+
+template <typename Operation>
+size_t countAllocations(Operation operation) {
+    const size_t before = allocationCount();
+    operation();
+    return allocationCount() - before;
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "ModPoly.h"
+#include <cstdint>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+static constexpr uint32_t NTT_PRIME = 998244353; // 119 * 2^23 + 1
+static constexpr uint32_t PLAIN_PRIME = 1000000007;
+
+using Mod = ModInt<NTT_PRIME>;
+
+TEST(ModInt, MatchesNaiveModularArithmetic) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<uint64_t> dist(0, NTT_PRIME - 1);
+    for (int i = 0; i < 1000; ++i) {
+        const uint64_t a = dist(rng), b = dist(rng);
+        EXPECT_EQ((Mod(a) + Mod(b)).get(), (a + b) % NTT_PRIME);
+        EXPECT_EQ((Mod(a) - Mod(b)).get(), (a + NTT_PRIME - b) % NTT_PRIME);
+        EXPECT_EQ((Mod(a) * Mod(b)).get(), a * b % NTT_PRIME);
+    }
+}
+
+TEST(ModInt, NegativeValuesAndInverse) {
+    EXPECT_EQ(Mod(-1).get(), NTT_PRIME - 1);
+    EXPECT_EQ((-Mod(0)).get(), 0u);
+    const Mod x = 123456789;
+    EXPECT_EQ((x * x.inverse()).get(), 1u);
+    EXPECT_EQ((x / x).get(), 1u);
+}
+
+TEST(ModInt, NttParameters) {
+    EXPECT_EQ(Ntt<NTT_PRIME>::TWO_ADICITY, 23);
+    EXPECT_EQ(Ntt<NTT_PRIME>::PRIMITIVE_ROOT, 3u);
+    EXPECT_EQ(Ntt<PLAIN_PRIME>::TWO_ADICITY, 1);
+}
+
+template <uint32_t P>
+static ModPoly<P> randomDense(std::mt19937& rng, int degree) {
+    std::uniform_int_distribution<long long> dist(0, P - 1);
+    std::map<int, ModInt<P>> terms;
+    for (int i = 0; i <= degree; ++i) terms[i] = dist(rng);
+    return ModPoly<P>(terms);
+}
+
+TEST(ModPoly, NttProductMatchesSchoolbook) {
+    std::mt19937 rng(11);
+    const auto a = randomDense<NTT_PRIME>(rng, 600);
+    const auto b = randomDense<NTT_PRIME>(rng, 500);
+    ModPoly<NTT_PRIME> schoolbook;
+    schoolbook.multiplyAccumulate(a, b);
+    EXPECT_EQ(a * b, schoolbook);
+}
+
+TEST(ModPoly, NttProductWithWrappedTopCoefficient) {
+    // degree 1024 product fits a length-1024 cyclic convolution plus the known top coefficient
+    std::mt19937 rng(12);
+    const auto a = randomDense<NTT_PRIME>(rng, 512);
+    const auto b = randomDense<NTT_PRIME>(rng, 512);
+    ModPoly<NTT_PRIME> schoolbook;
+    schoolbook.multiplyAccumulate(a, b);
+    EXPECT_EQ(a * b, schoolbook);
+}
+
+TEST(ModPoly, DenseNttProductMatchesTermProduct) {
+    std::mt19937 rng(14);
+    std::uniform_int_distribution<long long> dist(0, NTT_PRIME - 1);
+    // 513 + 513 coefficients wrap the top one around, a length-1 operand folds a[4] onto a[0]
+    for (const auto& sizes : {std::pair<int, int>(600, 501), {513, 513}, {5, 1}}) {
+        std::vector<Mod> a(sizes.first), b(sizes.second);
+        std::map<int, Mod> termsA, termsB;
+        for (int i = 0; i < sizes.first; ++i) termsA[i] = a[i] = dist(rng);
+        for (int i = 0; i < sizes.second; ++i) termsB[i] = b[i] = dist(rng);
+
+        const auto product = nttMultiply(a, b);
+        ASSERT_EQ(product.size(), a.size() + b.size() - 1);
+        const auto expected = ModPoly<NTT_PRIME>(termsA) * ModPoly<NTT_PRIME>(termsB);
+        for (size_t i = 0; i < product.size(); ++i) EXPECT_EQ(product[i], expected[static_cast<int>(i)]) << i;
+    }
+    EXPECT_TRUE(nttMultiply(std::vector<Mod>(), std::vector<Mod>(3, Mod(1))).empty());
+    EXPECT_THROW(nttMultiply(std::vector<ModInt<PLAIN_PRIME>>(3), std::vector<ModInt<PLAIN_PRIME>>(3)),
+                 std::length_error);
+}
+
+TEST(ModPoly, PlainPrimeFallsBackToSchoolbook) {
+    std::mt19937 rng(13);
+    const auto a = randomDense<PLAIN_PRIME>(rng, 300);
+    const auto b = randomDense<PLAIN_PRIME>(rng, 300);
+    ModPoly<PLAIN_PRIME> schoolbook;
+    schoolbook.multiplyAccumulate(a, b);
+    EXPECT_EQ(a * b, schoolbook);
+}
+
+TEST(ModPoly, ProductMatchesExactIntegerProduct) {
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<long long> dist(-1000, 1000);
+    std::map<int, long long> exactA, exactB;
+    std::map<int, Mod> modA, modB;
+    for (int i = 0; i <= 400; ++i) {
+        exactA[i] = dist(rng);
+        exactB[i] = dist(rng);
+        modA[i] = exactA[i];
+        modB[i] = exactB[i];
+    }
+    const BasicPoly<long long> exact = BasicPoly<long long>(exactA) * BasicPoly<long long>(exactB);
+    const ModPoly<NTT_PRIME> reduced = ModPoly<NTT_PRIME>(modA) * ModPoly<NTT_PRIME>(modB);
+    for (int i = 0; i <= 800; ++i) {
+        EXPECT_EQ(reduced[i], Mod(exact[i]));
+    }
+}
+
+TEST(ModPoly, CalculusAndEvaluation) {
+    const ModPoly<NTT_PRIME> p(std::map<int, Mod>{{3, 2}, {0, 5}});
+    EXPECT_EQ(p(Mod(2)).get(), 21u);
+    EXPECT_EQ(p.derivative(), ModPoly<NTT_PRIME>(std::map<int, Mod>{{2, 6}}));
+    EXPECT_EQ(p.integral().derivative(), p);
+}
+
+TEST(ModPoly, CalculusDropsTermsThatVanishModP) {
+    const ModPoly<NTT_PRIME> p(std::map<int, Mod>{{NTT_PRIME, 1}, {1, 1}});
+    EXPECT_EQ(p.derivative(), ModPoly<NTT_PRIME>(Mod(1)));
+    EXPECT_THROW(ModPoly<NTT_PRIME>(std::map<int, Mod>{{NTT_PRIME - 1, 1}}).integral(), std::domain_error);
+}
+
+TEST(ModPoly, StreamInsertion) {
+    std::ostringstream out;
+    out << ModPoly<NTT_PRIME>(std::map<int, Mod>{{2, 3}, {1, 1}, {0, -1}});
+    EXPECT_EQ(out.str(), "3x^2 + x + 998244352");
+}
+
+TEST(IntegerPoly, CalculusKeepsCoefficientsExact) {
+    const BasicPoly<long long> p(std::map<int, long long>{{2, 3}, {1, 2}, {0, -4}});
+    EXPECT_EQ(p.integral(), BasicPoly<long long>(std::map<int, long long>{{3, 1}, {2, 1}, {1, -4}}));
+    EXPECT_EQ(p.integral().derivative(), p);
+    EXPECT_EQ(BasicPoly<long long>(7).derivative(), BasicPoly<long long>());
+    // x / 2 has no integer coefficient
+    EXPECT_THROW(BasicPoly<long long>(std::map<int, long long>{{1, 1}}).integral(), std::domain_error);
+}
+
+TEST(IntegerPoly, StreamInsertionWritesSignsAsOperators) {
+    std::ostringstream out;
+    out << BasicPoly<long long>(std::map<int, long long>{{3, -2}, {2, 1}, {1, -1}, {0, -3}});
+    EXPECT_EQ(out.str(), "-2x^3 + x^2 - x - 3");
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "MultiPoly.h"
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static std::string toString(const MultiPoly& p) {
+    std::ostringstream out;
+    out << p;
+    return out.str();
+}
+
+static MultiPoly randomMultiPoly(std::mt19937& rng, int variables, int terms, int maxExponent) {
+    std::uniform_int_distribution<int> exponent(0, maxExponent);
+    std::uniform_int_distribution<int> coefficient(-9, 9);
+    MultiPoly p(variables);
+    std::vector<int> exponents(variables);
+    for (int i = 0; i < terms; ++i) {
+        for (auto& e : exponents) e = exponent(rng);
+        p.setCoefficient(exponents, coefficient(rng));
+    }
+    return p;
+}
+
+TEST(MultiPolyConstruction, ConstantAndVariables) {
+    const MultiPoly c(3, 2.5);
+    EXPECT_EQ(c.termCount(), 1u);
+    EXPECT_DOUBLE_EQ((c[{0, 0, 0}]), 2.5);
+    EXPECT_EQ(MultiPoly(3).termCount(), 0u);
+
+    const MultiPoly y = MultiPoly::variable(3, 2);
+    EXPECT_DOUBLE_EQ((y[{0, 1, 0}]), 1.0);
+    EXPECT_EQ(y.totalDegree(), 1);
+}
+
+TEST(MultiPolyConstruction, InvalidArgumentsThrow) {
+    EXPECT_THROW(MultiPoly(0), std::invalid_argument);
+    EXPECT_THROW(MultiPoly(MultiPoly::MAX_VARIABLES + 1), std::invalid_argument);
+    EXPECT_THROW(MultiPoly::variable(3, 4), std::invalid_argument);
+    MultiPoly p(2);
+    EXPECT_THROW(p.setCoefficient({1}, 1.0), std::invalid_argument);
+    EXPECT_THROW(p.setCoefficient({-1, 0}, 1.0), std::invalid_argument);
+    EXPECT_THROW(p.setCoefficient({p.maxDegree(), 1}, 1.0), std::overflow_error);
+    EXPECT_THROW(p += MultiPoly(3), std::invalid_argument);
+}
+
+TEST(MultiPolyArithmetic, AdditionCancelsTerms) {
+    const MultiPoly x = MultiPoly::variable(2, 1), y = MultiPoly::variable(2, 2);
+    const MultiPoly p = x + y;
+    EXPECT_EQ(p - y, x);
+    EXPECT_EQ(p - p, MultiPoly(2));
+    EXPECT_EQ(-p + p, MultiPoly(2));
+}
+
+TEST(MultiPolyArithmetic, MultiplicationExpandsProducts) {
+    const MultiPoly x = MultiPoly::variable(2, 1), y = MultiPoly::variable(2, 2);
+    // (x + y)(x - y) = x^2 - y^2
+    const MultiPoly p = (x + y) * (x - y);
+    EXPECT_EQ(p.termCount(), 2u);
+    EXPECT_DOUBLE_EQ((p[{2, 0}]), 1.0);
+    EXPECT_DOUBLE_EQ((p[{0, 2}]), -1.0);
+    EXPECT_DOUBLE_EQ((p[{1, 1}]), 0.0);
+}
+
+TEST(MultiPolyArithmetic, GradedOrderInOutput) {
+    const MultiPoly x = MultiPoly::variable(3, 1), y = MultiPoly::variable(3, 2), z = MultiPoly::variable(3, 3);
+    const MultiPoly p = (x + y + z + MultiPoly(3, 1.0)) * (x + MultiPoly(3, -1.0));
+    EXPECT_EQ(toString(p), "x1^2 + x1x2 + x1x3 - x2 - x3 - 1");
+}
+
+TEST(MultiPolyArithmetic, ProductOverflowThrows) {
+    MultiPoly p(6);
+    p.setCoefficient({p.maxDegree(), 0, 0, 0, 0, 0}, 1.0);
+    EXPECT_THROW(p * p, std::overflow_error);
+}
+
+TEST(MultiPolyArithmetic, RingAxiomsOnRandomInputs) {
+    std::mt19937 rng(5);
+    for (int i = 0; i < 20; ++i) {
+        const MultiPoly a = randomMultiPoly(rng, 4, 15, 4);
+        const MultiPoly b = randomMultiPoly(rng, 4, 15, 4);
+        const MultiPoly c = randomMultiPoly(rng, 4, 15, 4);
+        EXPECT_EQ(a * b, b * a);
+        EXPECT_EQ((a * b) * c, a * (b * c));
+        EXPECT_EQ(a * (b + c), a * b + a * c);
+    }
+}
+
+TEST(MultiPolyEvaluation, SinglePoint) {
+    const MultiPoly x = MultiPoly::variable(3, 1), y = MultiPoly::variable(3, 2), z = MultiPoly::variable(3, 3);
+    const MultiPoly p = x * x * y - z * MultiPoly(3, 3.0) + MultiPoly(3, 0.5);
+    EXPECT_DOUBLE_EQ(p({2.0, 3.0, 4.0}), 12.0 - 12.0 + 0.5);
+    EXPECT_THROW(p({1.0, 2.0}), std::invalid_argument);
+}
+
+TEST(MultiPolyEvaluation, HighExponentsDoNotNeedPowerTables) {
+    // a table with a row per power of x would take 10^7 * 256 doubles per evaluation block
+    MultiPoly p(1);
+    p.setCoefficient({10000000}, 2.0);
+    p.setCoefficient({65}, 3.0);
+    p.setCoefficient({2}, -1.0);
+    const std::vector<double> points = {1.0000001, -1.0, 0.5, 1.0, -0.99999995};
+
+    std::vector<double> values(points.size());
+    p.evaluate(points.data(), points.size(), values.data());
+    for (size_t k = 0; k < points.size(); ++k) {
+        const double x = points[k];
+        const double expected = 2.0 * std::pow(x, 10000000) + 3.0 * std::pow(x, 65) - x * x;
+        EXPECT_NEAR(values[k], expected, 1e-8 * std::fabs(expected)) << x;
+    }
+}
+
+TEST(MultiPolyEvaluation, ManyPointsMatchSinglePoint) {
+    std::mt19937 rng(9);
+    const MultiPoly p = randomMultiPoly(rng, 5, 40, 5);
+    const size_t count = 1000; // several evaluation blocks with a partial last one
+    std::uniform_real_distribution<double> coordinate(-1.5, 1.5);
+    std::vector<double> points(5 * count);
+    for (auto& x : points) x = coordinate(rng);
+
+    std::vector<double> values(count);
+    p.evaluate(points.data(), count, values.data());
+    for (size_t k = 0; k < count; k += 37) {
+        std::vector<double> point(5);
+        for (int v = 0; v < 5; ++v) point[v] = points[v * count + k];
+        EXPECT_NEAR(values[k], p(point), 1e-9 * (1.0 + std::fabs(values[k])));
+    }
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "Poly.h"
+#include <cmath>
+#include <map>
+#include <random>
+
+// Randomized checks of the ring axioms. Coefficients are small integers, so every sum and product
+// below is exact in double precision and results can be compared with ==.
+
+struct PolyShape
+{
+    const char* name;
+    int maxExponent;
+    int termCount;
+};
+
+static const PolyShape SHAPES[] = {
+    {"dense", 12, 13},
+    {"sparse", 5000, 6},
+    {"mixed", 60, 20},
+};
+
+static constexpr int ITERATIONS = 50;
+
+static Poly randomPoly(std::mt19937& rng, const PolyShape& shape) {
+    std::uniform_int_distribution<int> exponent(0, shape.maxExponent);
+    std::uniform_int_distribution<int> coefficient(-9, 9);
+    std::map<int, double> terms;
+    for (int i = 0; i < shape.termCount; ++i) {
+        terms[exponent(rng)] = coefficient(rng);
+    }
+    return Poly(terms);
+}
+
+class PolyRingAxioms : public ::testing::TestWithParam<PolyShape>
+{
+  protected:
+    std::mt19937 rng{20240611};
+    Poly next() { return randomPoly(rng, GetParam()); }
+};
+
+TEST_P(PolyRingAxioms, AdditionIsCommutativeAndAssociative) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const Poly a = next(), b = next(), c = next();
+        EXPECT_EQ(a + b, b + a);
+        EXPECT_EQ((a + b) + c, a + (b + c));
+    }
+}
+
+TEST_P(PolyRingAxioms, AdditiveIdentityAndInverse) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const Poly a = next();
+        EXPECT_EQ(a + Poly(), a);
+        EXPECT_EQ(a + (-a), Poly());
+        EXPECT_EQ(a - a, Poly());
+    }
+}
+
+TEST_P(PolyRingAxioms, MultiplicationIsCommutativeAndAssociative) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const Poly a = next(), b = next(), c = next();
+        EXPECT_EQ(a * b, b * a);
+        EXPECT_EQ((a * b) * c, a * (b * c));
+    }
+}
+
+TEST_P(PolyRingAxioms, MultiplicativeIdentityAndZero) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const Poly a = next();
+        EXPECT_EQ(a * Poly(1.0), a);
+        EXPECT_EQ(a * Poly(), Poly());
+    }
+}
+
+TEST_P(PolyRingAxioms, MultiplicationDistributesOverAddition) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const Poly a = next(), b = next(), c = next();
+        EXPECT_EQ(a * (b + c), a * b + a * c);
+        EXPECT_EQ((a - b) * c, a * c - b * c);
+    }
+}
+
+TEST_P(PolyRingAxioms, InPlaceOperationsMatchBinaryOperators) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const Poly a = next(), b = next(), c = next();
+        Poly sum = a, difference = a, product = a, accumulated = c, scaled = a;
+        sum += b;
+        difference -= b;
+        product *= b;
+        accumulated.multiplyAccumulate(a, b);
+        scaled.addScaled(b, -3.0);
+        EXPECT_EQ(sum, a + b);
+        EXPECT_EQ(difference, a - b);
+        EXPECT_EQ(product, a * b);
+        EXPECT_EQ(accumulated, c + a * b);
+        EXPECT_EQ(scaled, a - 3.0 * b);
+    }
+}
+
+TEST_P(PolyRingAxioms, EvaluationIsARingHomomorphism) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const Poly a = next(), b = next();
+        const double x = 0.75;
+        const double tolerance = 1e-9 * (1.0 + std::fabs(a(x)) * std::fabs(b(x)));
+        EXPECT_NEAR((a + b)(x), a(x) + b(x), tolerance);
+        EXPECT_NEAR((a * b)(x), a(x) * b(x), tolerance);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Shapes, PolyRingAxioms, ::testing::ValuesIn(SHAPES),
+                         [](const ::testing::TestParamInfo<PolyShape>& info) { return info.param.name; });
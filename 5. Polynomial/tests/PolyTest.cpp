@@ -0,0 +1,334 @@
+#include <gtest/gtest.h>
+#include "Poly.h"
+#include "AllocationCounter.h"
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+static std::string toString(const Poly& p) {
+    std::ostringstream out;
+    out << p;
+    return out.str();
+}
+
+static Poly makePoly(const std::map<int, double>& terms) { return Poly(terms); }
+
+// the binary form starts with the varint term count
+static size_t termCount(const Poly& p) {
+    std::vector<unsigned char> bytes;
+    p.serialize(bytes);
+    EXPECT_LT(bytes.at(0), 0x80) << "term count needs more than one varint byte";
+    return bytes.at(0);
+}
+
+TEST(PolyArithmetic, SubtractInPlace) {
+    Poly p1 = makePoly({{3, 4.0}, {1, 2.0}, {0, 1.0}});
+    Poly p2 = makePoly({{3, 1.0}, {2, 5.0}, {0, 1.0}});
+    p1 -= p2;
+    EXPECT_EQ(toString(p1), "3x^3 - 5x^2 + 2x");
+}
+
+TEST(PolyArithmetic, SubtractSelfGivesZero) {
+    Poly p = makePoly({{2, 1.5}, {0, 3.0}});
+    p -= p;
+    EXPECT_EQ(p, Poly());
+}
+
+TEST(PolyArithmetic, AddScaled) {
+    Poly p1 = makePoly({{2, 1.0}, {0, 1.0}});
+    Poly p2 = makePoly({{2, 0.5}, {1, 1.0}});
+    p1.addScaled(p2, -2.0);
+    EXPECT_EQ(p1, makePoly({{1, -2.0}, {0, 1.0}}));
+}
+
+TEST(PolyArithmetic, AddScaledSelf) {
+    Poly p = makePoly({{1, 2.0}});
+    p.addScaled(p, 2.0);
+    EXPECT_EQ(p, makePoly({{1, 6.0}}));
+}
+
+TEST(PolyArithmetic, MultiplyAccumulate) {
+    Poly acc = makePoly({{2, -1.0}, {0, 1.0}});
+    Poly a = makePoly({{1, 1.0}, {0, 1.0}});
+    Poly b = makePoly({{1, 1.0}, {0, -1.0}});
+    acc.multiplyAccumulate(a, b);
+    EXPECT_EQ(acc, Poly());
+}
+
+TEST(PolyArithmetic, MultiplyAccumulateAliased) {
+    Poly p = makePoly({{1, 1.0}, {0, 1.0}});
+    p.multiplyAccumulate(p, p);
+    EXPECT_EQ(p, makePoly({{2, 1.0}, {1, 3.0}, {0, 2.0}}));
+}
+
+TEST(PolyArithmetic, SelfMultiply) {
+    Poly p = makePoly({{1, 1.0}, {0, -1.0}});
+    p *= p;
+    EXPECT_EQ(p, makePoly({{2, 1.0}, {1, -2.0}, {0, 1.0}}));
+}
+
+TEST(PolyArithmetic, RvalueOperandsGiveSameResults) {
+    const Poly p1 = makePoly({{3, 1.0}, {1, 2.0}});
+    const Poly p2 = makePoly({{2, 4.0}, {1, 2.0}, {0, 1.0}});
+    EXPECT_EQ(p1 + Poly(p2), p1 + p2);
+    EXPECT_EQ(Poly(p1) + Poly(p2), p1 + p2);
+    EXPECT_EQ(p1 - Poly(p2), makePoly({{3, 1.0}, {2, -4.0}, {0, -1.0}}));
+    EXPECT_EQ(Poly(p2) - p1, makePoly({{3, -1.0}, {2, 4.0}, {0, 1.0}}));
+    EXPECT_EQ(-Poly(p1), -p1);
+    EXPECT_EQ(5.3 - p1, makePoly({{3, -1.0}, {1, -2.0}, {0, 5.3}}));
+    EXPECT_EQ(p1 - 5.3, makePoly({{3, 1.0}, {1, 2.0}, {0, -5.3}}));
+}
+
+TEST(PolyAllocations, SubtractWithExistingExponentsDoesNotAllocate) {
+    Poly p1 = makePoly({{4, 1.0}, {2, 2.0}, {0, 3.0}});
+    const Poly p2 = makePoly({{4, 5.0}, {0, 1.0}});
+    EXPECT_EQ(countAllocations([&] { p1 -= p2; }), 0u);
+    EXPECT_EQ(p1, makePoly({{4, -4.0}, {2, 2.0}, {0, 2.0}}));
+}
+
+TEST(PolyAllocations, AddScaledWithExistingExponentsDoesNotAllocate) {
+    Poly p1 = makePoly({{4, 1.0}, {2, 2.0}, {0, 3.0}});
+    const Poly p2 = makePoly({{2, 1.0}, {0, 1.0}});
+    EXPECT_EQ(countAllocations([&] { p1.addScaled(p2, 3.0); }), 0u);
+}
+
+TEST(PolyAllocations, AddRvalueStealsStorage) {
+    const Poly p1 = makePoly({{2, 1.0}, {0, 3.0}});
+    Poly p2 = makePoly({{2, 2.0}, {1, 1.0}, {0, 1.0}});
+    Poly sum;
+    EXPECT_EQ(countAllocations([&] { sum = p1 + std::move(p2); }), 0u);
+    EXPECT_EQ(sum, makePoly({{2, 3.0}, {1, 1.0}, {0, 4.0}}));
+}
+
+TEST(PolyAllocations, SubtractRvalueStealsStorage) {
+    Poly p1 = makePoly({{2, 1.0}, {1, 1.0}, {0, 3.0}});
+    const Poly p2 = makePoly({{1, 1.0}});
+    Poly difference;
+    EXPECT_EQ(countAllocations([&] { difference = std::move(p1) - p2; }), 0u);
+    EXPECT_EQ(difference, makePoly({{2, 1.0}, {0, 3.0}}));
+}
+
+TEST(PolyAllocations, MultiplyAccumulateReusesExistingTerms) {
+    Poly acc = makePoly({{2, 1.0}, {1, 1.0}, {0, 1.0}});
+    const Poly a = makePoly({{1, 1.0}, {0, 1.0}});
+    const Poly b = makePoly({{1, 2.0}, {0, 1.0}});
+    EXPECT_EQ(countAllocations([&] { acc.multiplyAccumulate(a, b); }), 0u);
+    EXPECT_EQ(acc, makePoly({{2, 3.0}, {1, 4.0}, {0, 2.0}}));
+}
+
+TEST(PolyAllocations, SelfMultiplyAllocatesOnlyResultTerms) {
+    Poly p = makePoly({{3, 1.0}, {2, 1.0}, {1, 1.0}, {0, 1.0}});
+    const size_t allocations = countAllocations([&] { p *= p; });
+    EXPECT_EQ(p, makePoly({{6, 1.0}, {5, 2.0}, {4, 3.0}, {3, 4.0}, {2, 3.0}, {1, 2.0}, {0, 1.0}}));
+    EXPECT_LE(allocations, termCount(p));
+}
+
+TEST(PolyCalculus, Derivative) {
+    const Poly p = makePoly({{4, 1.0}, {2, -3.0}, {1, 2.0}, {0, 7.0}});
+    EXPECT_EQ(p.derivative(), makePoly({{3, 4.0}, {1, -6.0}, {0, 2.0}}));
+    EXPECT_EQ(Poly(5.0).derivative(), Poly());
+}
+
+TEST(PolyCalculus, Integral) {
+    const Poly p = makePoly({{2, 3.0}, {0, 2.0}});
+    EXPECT_EQ(p.integral(), makePoly({{3, 1.0}, {1, 2.0}}));
+    EXPECT_EQ(p.integral(4.0), makePoly({{3, 1.0}, {1, 2.0}, {0, 4.0}}));
+    EXPECT_EQ(p.integral().derivative(), p);
+}
+
+TEST(PolyCalculus, Composition) {
+    const Poly p = makePoly({{3, 1.0}, {0, 1.0}});
+    const Poly q = makePoly({{1, 1.0}, {0, 1.0}});
+    EXPECT_EQ(composition(p, q), makePoly({{3, 1.0}, {2, 3.0}, {1, 3.0}, {0, 2.0}}));
+    EXPECT_EQ(composition(q, p), makePoly({{3, 1.0}, {0, 2.0}}));
+    EXPECT_EQ(composition(Poly(), q), Poly());
+}
+
+TEST(PolyCalculus, CompositionMatchesEvaluation) {
+    const Poly p = makePoly({{5, 0.5}, {2, -1.0}, {0, 3.0}});
+    const Poly q = makePoly({{2, 1.0}, {1, -2.0}});
+    const Poly pq = composition(p, q);
+    for (double x : {-1.5, 0.0, 0.25, 2.0}) {
+        EXPECT_NEAR(pq(x), p(q(x)), 1e-9);
+    }
+}
+
+TEST(PolyCalculus, BatchOperations) {
+    const std::vector<Poly> polys = {makePoly({{2, 1.0}}), makePoly({{3, 2.0}, {0, 1.0}})};
+    const auto d = derivatives(polys);
+    ASSERT_EQ(d.size(), 2u);
+    EXPECT_EQ(d[0], makePoly({{1, 2.0}}));
+    EXPECT_EQ(d[1], makePoly({{2, 6.0}}));
+    EXPECT_EQ(integrals(d, 1.0)[1], makePoly({{3, 2.0}, {0, 1.0}}));
+}
+
+static void expectRoots(const std::vector<double>& actual, const std::vector<double>& expected, double eps) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(actual[i], expected[i], eps);
+    }
+}
+
+TEST(PolyRoots, QuadraticWithComplexRoots) {
+    const Poly p = makePoly({{2, 1.0}, {0, 1.0}});
+    const auto roots = p.roots();
+    ASSERT_EQ(roots.size(), 2u);
+    for (const auto& root : roots) {
+        EXPECT_NEAR(std::abs(root.imag()), 1.0, 1e-12);
+        EXPECT_NEAR(root.real(), 0.0, 1e-12);
+    }
+    EXPECT_TRUE(p.realRoots().empty());
+}
+
+TEST(PolyRoots, SmallDegreeUsesCompanionMatrix) {
+    // (x - 1)(x - 2)(x + 3)(x^2 + 1)
+    Poly p = makePoly({{1, 1.0}, {0, -1.0}});
+    p *= makePoly({{1, 1.0}, {0, -2.0}});
+    p *= makePoly({{1, 1.0}, {0, 3.0}});
+    p *= makePoly({{2, 1.0}, {0, 1.0}});
+    expectRoots(p.realRoots(), {-3.0, 1.0, 2.0}, 1e-10);
+}
+
+TEST(PolyRoots, ZeroRootsAreFactoredOut) {
+    const Poly p = makePoly({{5, 1.0}, {3, -4.0}});
+    expectRoots(p.realRoots(), {-2.0, 0.0, 0.0, 0.0, 2.0}, 1e-12);
+    EXPECT_TRUE(Poly(3.0).roots().empty());
+    EXPECT_THROW(Poly().roots(), std::invalid_argument);
+}
+
+TEST(PolyRoots, StoredZeroCoefficientsAreIgnored) {
+    // the non-const operator[] stores a zero coefficient for every exponent it is asked for
+    Poly p;
+    p[2] = 1;
+    p[0] = -1;
+    p[5];
+    p[1];
+    expectRoots(p.realRoots(), {-1.0, 1.0}, 1e-12);
+
+    Poly zero;
+    zero[3];
+    zero[0];
+    EXPECT_THROW(zero.roots(), std::invalid_argument);
+}
+
+TEST(PolyRoots, HighDegreeUsesAberthIteration) {
+    // (x^60 - 1)(x - 0.5)
+    Poly p = makePoly({{60, 1.0}, {0, -1.0}});
+    p *= makePoly({{1, 1.0}, {0, -0.5}});
+    EXPECT_EQ(p.roots().size(), 61u);
+    expectRoots(p.realRoots(), {-1.0, 0.5, 1.0}, 1e-10);
+}
+
+TEST(PolyRoots, BatchRealRoots) {
+    const std::vector<Poly> polys = {makePoly({{2, 1.0}, {0, -4.0}}), makePoly({{1, 2.0}, {0, 1.0}})};
+    const auto roots = realRoots(polys);
+    ASSERT_EQ(roots.size(), 2u);
+    expectRoots(roots[0], {-2.0, 2.0}, 1e-12);
+    expectRoots(roots[1], {-0.5}, 1e-12);
+}
+
+TEST(PolyFormat, ToCharsMatchesStreamOutput) {
+    const Poly p = makePoly({{3, -2.3}, {2, 5.0}, {1, 1.0}, {0, -4.5}});
+    char buffer[64];
+    const auto result = p.toChars(buffer, buffer + sizeof(buffer));
+    ASSERT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string(buffer, result.ptr), toString(p));
+    EXPECT_EQ(toString(p), "-2.3x^3 + 5x^2 + x - 4.5");
+}
+
+TEST(PolyFormat, StreamInsertionHonorsStreamFormat) {
+    const Poly p = makePoly({{2, 3.14159265358979}, {1, 1234567.0}, {0, -0.5}});
+    EXPECT_EQ(toString(p), "3.14159x^2 + 1.23457e+06x - 0.5");
+
+    std::ostringstream out;
+    out << std::setprecision(15) << p << '\n';
+    out << std::fixed << std::setprecision(2) << p << '\n';
+    out << std::scientific << std::uppercase << std::setprecision(1) << p << '\n';
+    out << std::defaultfloat << std::nouppercase << std::setprecision(3) << makePoly({{1, 100.0}, {0, 1000.0}});
+    EXPECT_EQ(out.str(), "3.14159265358979x^2 + 1234567x - 0.5\n"
+                         "3.14x^2 + 1234567.00x - 0.50\n"
+                         "3.1E+00x^2 + 1.2E+06x - 5.0E-01\n"
+                         "100x + 1e+03");
+
+    // terms longer than the formatting buffer
+    std::ostringstream large;
+    large << std::fixed << std::setprecision(0) << makePoly({{1, 1e300}});
+    std::ostringstream expected;
+    expected << std::fixed << std::setprecision(0) << 1e300 << "x";
+    EXPECT_EQ(large.str(), expected.str());
+}
+
+TEST(PolyFormat, ToCharsZeroPolynomial) {
+    char buffer[4];
+    const auto result = Poly().toChars(buffer, buffer + sizeof(buffer));
+    ASSERT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string(buffer, result.ptr), "0");
+}
+
+TEST(PolyFormat, ToCharsReportsSmallBuffer) {
+    const Poly p = makePoly({{10, 3.0}, {0, 1.0}});
+    char buffer[6];
+    EXPECT_EQ(p.toChars(buffer, buffer + sizeof(buffer)).ec, std::errc::value_too_large);
+}
+
+TEST(PolyFormat, ParseStreamNotation) {
+    EXPECT_EQ(Poly::parse("3x^2 - x + 1"), makePoly({{2, 3.0}, {1, -1.0}, {0, 1.0}}));
+    EXPECT_EQ(Poly::parse("-2.3x^3 + 5x^2 - 4.5"), makePoly({{3, -2.3}, {2, 5.0}, {0, -4.5}}));
+    EXPECT_EQ(Poly::parse("-x"), makePoly({{1, -1.0}}));
+    EXPECT_EQ(Poly::parse("0"), Poly());
+    EXPECT_EQ(Poly::parse("  x^2+x-x "), makePoly({{2, 1.0}}));
+}
+
+TEST(PolyFormat, ParseRejectsMalformedText) {
+    EXPECT_THROW(Poly::parse(""), std::invalid_argument);
+    EXPECT_THROW(Poly::parse("3x^"), std::invalid_argument);
+    EXPECT_THROW(Poly::parse("x^-2"), std::invalid_argument);
+    EXPECT_THROW(Poly::parse("2x +"), std::invalid_argument);
+    EXPECT_THROW(Poly::parse("2y"), std::invalid_argument);
+}
+
+TEST(PolyFormat, ParseRoundTrip) {
+    const Poly p = makePoly({{1000, 1.0}, {350, 6.0}, {7, -0.125}, {0, 15.0}});
+    EXPECT_EQ(Poly::parse(toString(p)), p);
+}
+
+TEST(PolySerialization, RoundTrip) {
+    const Poly p = makePoly({{1000000, 1.0}, {350, -6.0}, {7, 0.1}, {0, -1e300}});
+    std::vector<unsigned char> data;
+    p.serialize(data);
+    Poly decoded;
+    EXPECT_EQ(Poly::deserialize(data.data(), data.data() + data.size(), decoded), data.data() + data.size());
+    EXPECT_EQ(decoded, p);
+}
+
+TEST(PolySerialization, SparseIntegerPolynomialIsCompact) {
+    const Poly p = makePoly({{1000, 1.0}, {350, 6.0}, {0, 15.0}});
+    std::vector<unsigned char> data;
+    p.serialize(data);
+    // count + 3 * (exponent delta + coefficient), each at most 2 bytes
+    EXPECT_LE(data.size(), 1u + 3u * 4u);
+}
+
+TEST(PolySerialization, SeveralPolynomialsInOneBuffer) {
+    const Poly p1 = makePoly({{2, 1.5}});
+    const Poly p2 = Poly();
+    std::vector<unsigned char> data;
+    p1.serialize(data);
+    p2.serialize(data);
+    Poly d1 = 7.0, d2 = 7.0;
+    const unsigned char* next = Poly::deserialize(data.data(), data.data() + data.size(), d1);
+    Poly::deserialize(next, data.data() + data.size(), d2);
+    EXPECT_EQ(d1, p1);
+    EXPECT_EQ(d2, p2);
+}
+
+TEST(PolySerialization, TruncatedDataThrows) {
+    std::vector<unsigned char> data;
+    makePoly({{5, 0.3}}).serialize(data);
+    Poly decoded;
+    EXPECT_THROW(Poly::deserialize(data.data(), data.data() + data.size() - 1, decoded), std::invalid_argument);
+}
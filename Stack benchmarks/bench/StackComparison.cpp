@@ -0,0 +1,148 @@
+// Every int stack in the repository under the same benchmarks, in one report:
+//   PushPop        range(0) pushes into a fresh stack, growth included, then range(0) pops
+//   CopyConstruct  copying a stack of range(0) items
+//   Assign         assigning a stack of range(0) items over one that already holds range(0) items
+//   PushLatency    per-push latency percentiles (p50/p99/max, ns) over a fresh stack growing to range(0)
+// Run with --benchmark_format=json (or csv, or --benchmark_out=<file>) for machine-readable output.
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+extern "C" {
+#include "../../1. Stack in C/include/Stack.h"
+}
+
+// each C++ variant is compiled with Stack renamed, see CMakeLists.txt
+#define Stack MallocStack
+#include "../../2. STACK IN CPP/include/Stack.h"
+#undef Stack
+#define Stack CStyleStack
+#include "../../3. EXTENDED STACK IN CPP, GDB/0. C-style memory management/include/Stack.h"
+#undef Stack
+#define Stack UniquePtrStack
+#include "../../3. EXTENDED STACK IN CPP, GDB/1. Unique pointers/include/Stack.h"
+#undef Stack
+#define Stack VectorStack
+#include "../../3. EXTENDED STACK IN CPP, GDB/2. Vector stack/include/Stack.h"
+#undef Stack
+#define Stack ExceptionsStack
+#include "../../3. EXTENDED STACK IN CPP, GDB/3. exceptions/include/Stack.h"
+#undef Stack
+#define Stack TemplateStack
+#include "../../3. EXTENDED STACK IN CPP, GDB/4. Template stack/include/Stack.h"
+#undef Stack
+
+using TemplateIntStack = TemplateStack<int>;
+
+// the C stack behind the push/pop/isEmpty interface of the C++ classes; copies go through the bulk API
+class CStack {
+private:
+    ::Stack stack;
+
+public:
+    CStack() { init(&stack); }
+    CStack(const CStack& toCopy) : CStack() { *this = toCopy; }
+    CStack& operator=(const CStack& toCopy) {
+        if (this != &toCopy) {
+            stackPopN(&stack, nullptr, stackSize(&stack));
+            stackPushN(&stack, toCopy.stack.items, stackSize(&toCopy.stack));
+        }
+        return *this;
+    }
+    ~CStack() { destroy(&stack); }
+
+    void push(int item) { ::push(&stack, item); }
+    int pop() { return ::pop(&stack); }
+    bool isEmpty() const { return ::isEmpty(&stack); }
+};
+
+template <typename StackType>
+static void fill(StackType& stack, int n) {
+    for (int i = 0; i < n; ++i) stack.push(i);
+}
+
+template <typename StackType>
+static void BM_PushPop(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        StackType stack;
+        fill(stack, n);
+        while (!stack.isEmpty()) benchmark::DoNotOptimize(stack.pop());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename StackType>
+static void BM_CopyConstruct(benchmark::State& state) {
+    StackType source;
+    fill(source, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        StackType copy(source);
+        benchmark::DoNotOptimize(&copy);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+}
+
+template <typename StackType>
+static void BM_Assign(benchmark::State& state) {
+    StackType source, target;
+    fill(source, static_cast<int>(state.range(0)));
+    fill(target, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        target = source;
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+}
+
+// each push timed on its own; the percentiles show how rare and how long the pushes that grow are
+template <typename StackType>
+static void BM_PushLatency(benchmark::State& state) {
+    using Clock = std::chrono::steady_clock;
+    const int n = static_cast<int>(state.range(0));
+    std::vector<double> latencies;
+    for (auto _ : state) {
+        state.PauseTiming();
+        latencies.reserve(latencies.size() + n);
+        state.ResumeTiming();
+        StackType stack;
+        for (int i = 0; i < n; ++i) {
+            const auto start = Clock::now();
+            stack.push(i);
+            latencies.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["p50_ns"] = latencies[latencies.size() / 2];
+    state.counters["p99_ns"] = latencies[latencies.size() * 99 / 100];
+    state.counters["max_ns"] = latencies.back();
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define STACK_BENCHMARKS(StackType)                                                                           \
+    BENCHMARK_TEMPLATE(BM_PushPop, StackType)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);                     \
+    BENCHMARK_TEMPLATE(BM_PushLatency, StackType)->Arg(1 << 10)->Arg(1 << 20)->Iterations(5)
+
+// copying and assigning, for the stacks that support them
+#define STACK_COPY_BENCHMARKS(StackType)                                                                      \
+    BENCHMARK_TEMPLATE(BM_CopyConstruct, StackType)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);               \
+    BENCHMARK_TEMPLATE(BM_Assign, StackType)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20)
+
+STACK_BENCHMARKS(CStack);
+STACK_BENCHMARKS(MallocStack);
+STACK_BENCHMARKS(CStyleStack);
+STACK_BENCHMARKS(UniquePtrStack);
+STACK_BENCHMARKS(VectorStack);
+STACK_BENCHMARKS(ExceptionsStack);
+STACK_BENCHMARKS(TemplateIntStack);
+
+// MallocStack has no copy constructor: the implicit one shares the buffer, so it is left out
+STACK_COPY_BENCHMARKS(CStack);
+STACK_COPY_BENCHMARKS(CStyleStack);
+STACK_COPY_BENCHMARKS(UniquePtrStack);
+STACK_COPY_BENCHMARKS(VectorStack);
+STACK_COPY_BENCHMARKS(ExceptionsStack);
+STACK_COPY_BENCHMARKS(TemplateIntStack);
+
+BENCHMARK_MAIN();
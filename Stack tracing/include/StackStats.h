@@ -0,0 +1,129 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+
+// Operation and growth counters shared by the int stacks of "2. STACK IN CPP" and "3. EXTENDED STACK IN CPP, GDB",
+// recorded only in builds with STACK_TRACING defined (cmake -DSTACK_TRACING=ON); otherwise the STACK_TRACE hooks
+// compile to nothing and stacks carry no tracer. Each stack counts for itself and adds every event to
+// StackStats::global() too.
+struct StackStats {
+    // bucket i counts growths to a capacity in [2^i, 2^(i+1)) items
+    static constexpr size_t HISTOGRAM_BUCKETS = 64;
+
+    size_t pushes = 0;
+    size_t pops = 0;
+    size_t growths = 0;
+    // bytes of items each growth had to relocate; realloc may have grown the block in place
+    size_t bytesCopied = 0;
+    size_t peakDepth = 0;
+    std::array<size_t, HISTOGRAM_BUCKETS> growthHistogram{};
+
+    static size_t bucketOf(size_t capacity) {
+        size_t bucket = 0;
+        while (capacity >> (bucket + 1) != 0 && bucket + 1 < HISTOGRAM_BUCKETS) ++bucket;
+        return bucket;
+    }
+
+    // totals over every stack; peakDepth is the deepest any one stack has been
+    static StackStats global();
+    static void resetGlobal();
+
+    void dump(std::ostream& out) const {
+        out << "pushes " << pushes << ", pops " << pops << ", growths " << growths << ", bytes copied "
+            << bytesCopied << ", peak depth " << peakDepth << "\n";
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+            if (growthHistogram[i] == 0) continue;
+            out << "  growths to capacity [" << (size_t(1) << i) << ", " << (size_t(2) << i)
+                << "): " << growthHistogram[i] << "\n";
+        }
+    }
+};
+
+// global counters, updated from any thread
+struct GlobalStackCounters {
+    std::atomic<size_t> pushes{0};
+    std::atomic<size_t> pops{0};
+    std::atomic<size_t> growths{0};
+    std::atomic<size_t> bytesCopied{0};
+    std::atomic<size_t> peakDepth{0};
+    std::array<std::atomic<size_t>, StackStats::HISTOGRAM_BUCKETS> growthHistogram{};
+
+    static GlobalStackCounters& instance() {
+        static GlobalStackCounters counters;
+        return counters;
+    }
+};
+
+inline StackStats StackStats::global() {
+    const auto& counters = GlobalStackCounters::instance();
+    StackStats stats;
+    stats.pushes = counters.pushes.load(std::memory_order_relaxed);
+    stats.pops = counters.pops.load(std::memory_order_relaxed);
+    stats.growths = counters.growths.load(std::memory_order_relaxed);
+    stats.bytesCopied = counters.bytesCopied.load(std::memory_order_relaxed);
+    stats.peakDepth = counters.peakDepth.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        stats.growthHistogram[i] = counters.growthHistogram[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+inline void StackStats::resetGlobal() {
+    auto& counters = GlobalStackCounters::instance();
+    counters.pushes = 0;
+    counters.pops = 0;
+    counters.growths = 0;
+    counters.bytesCopied = 0;
+    counters.peakDepth = 0;
+    for (auto& bucket : counters.growthHistogram) bucket = 0;
+}
+
+// The counters of one stack. They belong to that stack: a copy starts from zero, and assigning to a
+// stack keeps its own counts.
+class StackTracer {
+private:
+    StackStats stats;
+
+public:
+    StackTracer() = default;
+    StackTracer(const StackTracer&) {}
+    StackTracer& operator=(const StackTracer&) { return *this; }
+
+    void push(size_t n, size_t depth) {
+        auto& global = GlobalStackCounters::instance();
+        stats.pushes += n;
+        global.pushes.fetch_add(n, std::memory_order_relaxed);
+        if (depth > stats.peakDepth) {
+            stats.peakDepth = depth;
+            size_t peak = global.peakDepth.load(std::memory_order_relaxed);
+            while (depth > peak && !global.peakDepth.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    void pop(size_t n) {
+        stats.pops += n;
+        GlobalStackCounters::instance().pops.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void growth(size_t newCapacity, size_t bytesCopied) {
+        auto& global = GlobalStackCounters::instance();
+        const size_t bucket = StackStats::bucketOf(newCapacity);
+        ++stats.growths;
+        stats.bytesCopied += bytesCopied;
+        ++stats.growthHistogram[bucket];
+        global.growths.fetch_add(1, std::memory_order_relaxed);
+        global.bytesCopied.fetch_add(bytesCopied, std::memory_order_relaxed);
+        global.growthHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const StackStats& getStats() const { return stats; }
+};
+
+#ifdef STACK_TRACING
+#define STACK_TRACE(call) tracer.call
+#else
+#define STACK_TRACE(call) ((void)0)
+#endif
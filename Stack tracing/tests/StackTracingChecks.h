@@ -0,0 +1,69 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "StackStats.h"
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+// Checks shared by the tracing tests of every int stack; each test file passes in what differs between the
+// variants. StackType needs push, pop, pushRange, popN and getStats().
+
+// Pushes 100 items into an empty stack and pops 30. capacities holds the stack's initial capacity followed
+// by every capacity push() grows to; each growth relocates the whole old buffer.
+template <typename StackType>
+void expectPushPopTrace(const std::vector<size_t>& capacities) {
+    StackStats::resetGlobal();
+    StackType stack;
+    for (int i = 0; i < 100; ++i) stack.push(i);
+    for (int i = 0; i < 30; ++i) stack.pop();
+
+    const StackStats& stats = stack.getStats();
+    EXPECT_EQ(100u, stats.pushes);
+    EXPECT_EQ(30u, stats.pops);
+    EXPECT_EQ(100u, stats.peakDepth);
+    EXPECT_EQ(capacities.size() - 1, stats.growths);
+    EXPECT_EQ(std::accumulate(capacities.begin(), capacities.end() - 1, size_t(0)) * sizeof(int), stats.bytesCopied);
+    for (size_t i = 1; i < capacities.size(); ++i) {
+        EXPECT_EQ(1u, stats.growthHistogram[StackStats::bucketOf(capacities[i])]) << capacities[i];
+    }
+}
+
+// Bulk operations grow straight to the 1000 items pushed, and the global totals cover every stack.
+template <typename StackType>
+void expectBulkAndGlobalTrace() {
+    StackStats::resetGlobal();
+    StackType a, b;
+    std::vector<int> values(1000, 1);
+    a.pushRange(values.begin(), values.end());
+    a.popN(400, values.begin());
+    b.push(1);
+
+    EXPECT_EQ(1000u, a.getStats().pushes);
+    EXPECT_EQ(400u, a.getStats().pops);
+    EXPECT_EQ(1u, a.getStats().growths);
+    EXPECT_EQ(1u, a.getStats().growthHistogram[StackStats::bucketOf(1000)]);
+
+    const StackStats global = StackStats::global();
+    EXPECT_EQ(1001u, global.pushes);
+    EXPECT_EQ(400u, global.pops);
+    EXPECT_EQ(1000u, global.peakDepth);
+
+    std::ostringstream out;
+    global.dump(out);
+    EXPECT_EQ("pushes 1001, pops 400, growths 1, bytes copied 0, peak depth 1000\n"
+              "  growths to capacity [512, 1024): 1\n",
+              out.str());
+}
+
+// Counters belong to the stack: a copy starts from zero, and assignment keeps the target's own counts.
+template <typename StackType>
+void expectCopiesTraceSeparately() {
+    StackType a, b;
+    for (int i = 0; i < 10; ++i) a.push(i);
+    b.push(1);
+    StackType copy = a;
+    EXPECT_EQ(0u, copy.getStats().pushes);
+    b = a;
+    EXPECT_EQ(1u, b.getStats().pushes);
+    EXPECT_EQ(10u, a.getStats().pushes);
+}